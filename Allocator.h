@@ -0,0 +1,385 @@
+/**
+ * @file Allocator.h
+ * @brief Pluggable memory allocators for the container classes
+ *
+ * Defines the allocator interface accepted by Vector, Stack and Queue together
+ * with implementations suited to request-scoped workloads, where thousands of
+ * short-lived containers would otherwise hit the global allocator.
+ *
+ * Features:
+ * - Allocator interface with a global heap default
+ * - Monotonic arena: bump allocation, everything released at once on Reset()
+ * - Size-class pool: recycles freed blocks through per-class free lists
+ */
+
+// filepath: e:\Playground\Allocator.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <new>
+#include <assert.h>
+
+/**
+ * @class Allocator
+ * @brief Abstract memory resource used by the containers
+ *
+ * Containers pass the block size and alignment back on Deallocate() so
+ * implementations do not have to store a header in front of every block.
+ */
+class Allocator {
+public:
+	virtual ~Allocator() {}
+
+	/**
+	 * @brief Allocates a block of memory
+	 * @param bytes Number of bytes requested
+	 * @param alignment Required alignment (power of two)
+	 * @return Pointer to the block, never null
+	 */
+	virtual void* Allocate(size_t bytes, size_t alignment = alignof(max_align_t)) = 0;
+
+	/**
+	 * @brief Returns a block previously obtained from Allocate()
+	 * @param block Pointer returned by Allocate()
+	 * @param bytes The size that was passed to Allocate()
+	 * @param alignment The alignment that was passed to Allocate()
+	 */
+	virtual void Deallocate(void* block, size_t bytes, size_t alignment = alignof(max_align_t)) = 0;
+
+	/**
+	 * @brief Resizes a block, preserving the bytes in use
+	 * @param block Block to resize, or null for a fresh allocation
+	 * @param oldBytes Current size of the block
+	 * @param newBytes Requested size
+	 * @param usedBytes Number of leading bytes that must be preserved
+	 * @return Pointer to the resized block (may differ from block)
+	 *
+	 * The default allocates, copies and frees. Implementations that can
+	 * grow in place (e.g. via mremap) override this to avoid the copy.
+	 */
+	virtual void* Reallocate(void* block, size_t oldBytes, size_t newBytes, size_t usedBytes) {
+		void* fresh = Allocate(newBytes);
+		if (block) {
+			memcpy(fresh, block, usedBytes);
+			Deallocate(block, oldBytes);
+		}
+		return fresh;
+	}
+
+	/**
+	 * @brief Hands back storage persisted by a previous run, if any
+	 * @param bytes Receives the size of the restored block
+	 * @param usedBytes Receives the number of bytes that were in use
+	 * @return The restored block, or null when there is nothing to restore
+	 */
+	virtual void* Restore(size_t& /*bytes*/, size_t& /*usedBytes*/) {
+		return nullptr;
+	}
+
+	/**
+	 * @brief Records how many bytes of a block are in use
+	 * @param block Block returned by this allocator
+	 * @param usedBytes Number of leading bytes holding live data
+	 *
+	 * Only meaningful for persistent allocators; a no-op by default.
+	 */
+	virtual void Persist(void* /*block*/, size_t /*usedBytes*/) {
+	}
+
+	/**
+	 * @brief Returns the process-wide allocator backed by operator new
+	 * @return Pointer to the shared heap allocator
+	 *
+	 * Used by the containers when no allocator is supplied.
+	 */
+	static Allocator* Default();
+};
+
+/**
+ * @class HeapAllocator
+ * @brief Allocator backed by malloc/free
+ *
+ * Over-aligned blocks come from posix_memalign, which free() also
+ * releases, so Deallocate() does not need to know the alignment.
+ */
+class HeapAllocator : public Allocator {
+public:
+	void* Allocate(size_t bytes, size_t alignment = alignof(max_align_t)) override {
+		void* block = nullptr;
+		if (alignment > alignof(max_align_t)) {
+			if (posix_memalign(&block, alignment, bytes ? bytes : 1) != 0)
+				block = nullptr;
+		}
+		else {
+			block = malloc(bytes ? bytes : 1);
+		}
+		if (!block)
+			throw std::bad_alloc();
+		return block;
+	}
+
+	void Deallocate(void* block, size_t /*bytes*/, size_t /*alignment*/ = alignof(max_align_t)) override {
+		free(block);
+	}
+};
+
+inline Allocator* Allocator::Default() {
+	static HeapAllocator heap;
+	return &heap;
+}
+
+/**
+ * @class ArenaAllocator
+ * @brief Monotonic bump allocator released all at once
+ *
+ * Allocation only advances a cursor inside the current block; when the block
+ * is exhausted a new one is taken from the upstream allocator. Deallocate()
+ * is a no-op except for the most recent block, which is rolled back so a
+ * growing container can reuse the space. Reset() discards every allocation
+ * in one step, so containers built on the arena must not be used afterwards.
+ */
+class ArenaAllocator : public Allocator {
+public:
+	/**
+	 * @brief Constructs an empty arena
+	 * @param blockSize Size of each block requested from upstream
+	 * @param upstream Allocator providing the blocks (heap if null)
+	 */
+	explicit ArenaAllocator(size_t blockSize = 64 * 1024, Allocator* upstream = nullptr)
+		: blocks(nullptr), cursor(nullptr), limit(nullptr), lastAllocation(nullptr),
+		  blockSize(blockSize), upstream(upstream ? upstream : Allocator::Default())
+	{
+	}
+
+	ArenaAllocator(const ArenaAllocator&) = delete;
+	ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+	~ArenaAllocator() {
+		Release();
+	}
+
+	/**
+	 * @brief Bump-allocates a block from the current arena block
+	 *
+	 * Time complexity: O(1)
+	 */
+	void* Allocate(size_t bytes, size_t alignment = alignof(max_align_t)) override {
+		char* start = AlignUp(cursor, alignment);
+		if (!cursor || start + bytes > limit) {
+			NewBlock(bytes + alignment);
+			start = AlignUp(cursor, alignment);
+		}
+		cursor = start + bytes;
+		lastAllocation = start;
+		return start;
+	}
+
+	/**
+	 * @brief Releases a block; only the most recent allocation is reclaimed
+	 */
+	void Deallocate(void* block, size_t bytes, size_t /*alignment*/ = alignof(max_align_t)) override {
+		if (block == lastAllocation && (char*)block + bytes == cursor) {
+			cursor = (char*)block;
+			lastAllocation = nullptr;
+		}
+	}
+
+	/**
+	 * @brief Discards every allocation made from the arena
+	 *
+	 * Keeps the most recent block for reuse and returns the rest upstream.
+	 * Time complexity: O(number of blocks), independent of allocation count
+	 */
+	void Reset() {
+		if (!blocks)
+			return;
+		Block* keep = blocks;
+		blocks = blocks->next;
+		Release();
+		keep->next = nullptr;
+		blocks = keep;
+		cursor = (char*)(keep + 1);
+		limit = (char*)keep + keep->size;
+	}
+
+	/**
+	 * @brief Returns every block to the upstream allocator
+	 */
+	void Release() {
+		while (blocks) {
+			Block* next = blocks->next;
+			upstream->Deallocate(blocks, blocks->size);
+			blocks = next;
+		}
+		cursor = limit = lastAllocation = nullptr;
+	}
+
+private:
+	/**
+	 * @brief Header placed at the start of every block taken from upstream
+	 */
+	struct Block {
+		Block* next;   ///< Previously allocated block
+		size_t size;   ///< Total size of this block including the header
+	};
+
+	void NewBlock(size_t minimum) {
+		size_t size = sizeof(Block) + minimum;
+		if (size < blockSize)
+			size = blockSize;
+		Block* block = (Block*)upstream->Allocate(size);
+		block->next = blocks;
+		block->size = size;
+		blocks = block;
+		cursor = (char*)(block + 1);
+		limit = (char*)block + size;
+	}
+
+	static char* AlignUp(char* p, size_t alignment) {
+		return (char*)(((uintptr_t)p + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	}
+
+	Block* blocks;         ///< Singly linked list of blocks, newest first
+	char* cursor;          ///< Next free byte in the current block
+	char* limit;           ///< End of the current block
+	char* lastAllocation;  ///< Start of the most recent allocation (for rollback)
+	size_t blockSize;      ///< Default block size requested from upstream
+	Allocator* upstream;   ///< Source of the blocks
+};
+
+/**
+ * @class PoolAllocator
+ * @brief Size-class pool allocator with per-class free lists
+ *
+ * Requests up to MaxPooledSize bytes are rounded up to a power-of-two size
+ * class and served from that class's free list. Empty free lists are refilled
+ * by carving a slab obtained from the upstream allocator. Larger requests, and
+ * requests aligned beyond MinClassSize, go straight to upstream; Deallocate()
+ * routes blocks back on the same size and alignment, so those never enter a
+ * free list. Release() returns every slab in one pass.
+ */
+class PoolAllocator : public Allocator {
+public:
+	static const size_t MinClassSize = 16;    ///< Smallest size class in bytes
+	static const size_t MaxPooledSize = 4096; ///< Largest size served from the pool
+	static const int ClassCount = 9;          ///< Size classes 16, 32, ..., 4096
+
+	/**
+	 * @brief Constructs an empty pool
+	 * @param slabSize Size of each slab carved into blocks
+	 * @param upstream Allocator providing the slabs (heap if null)
+	 */
+	explicit PoolAllocator(size_t slabSize = 64 * 1024, Allocator* upstream = nullptr)
+		: slabs(nullptr), slabSize(slabSize), upstream(upstream ? upstream : Allocator::Default())
+	{
+		assert(slabSize >= MaxPooledSize + sizeof(Slab));
+		for (int i = 0; i < ClassCount; ++i)
+			freeLists[i] = nullptr;
+	}
+
+	PoolAllocator(const PoolAllocator&) = delete;
+	PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+	~PoolAllocator() {
+		Release();
+	}
+
+	/**
+	 * @brief Pops a block from the matching size class
+	 *
+	 * Time complexity: O(1), plus slab carving when the class is empty
+	 */
+	void* Allocate(size_t bytes, size_t alignment = alignof(max_align_t)) override {
+		if (!Pooled(bytes, alignment))
+			return upstream->Allocate(bytes, alignment);
+		int c = SizeClass(bytes);
+		if (!freeLists[c])
+			Refill(c);
+		FreeBlock* block = freeLists[c];
+		freeLists[c] = block->next;
+		return block;
+	}
+
+	/**
+	 * @brief Pushes a block back onto its size class free list
+	 *
+	 * Time complexity: O(1)
+	 */
+	void Deallocate(void* block, size_t bytes, size_t alignment = alignof(max_align_t)) override {
+		if (!Pooled(bytes, alignment)) {
+			upstream->Deallocate(block, bytes, alignment);
+			return;
+		}
+		int c = SizeClass(bytes);
+		FreeBlock* freed = (FreeBlock*)block;
+		freed->next = freeLists[c];
+		freeLists[c] = freed;
+	}
+
+	/**
+	 * @brief Returns every slab to upstream, invalidating all pooled blocks
+	 *
+	 * Blocks larger than MaxPooledSize or aligned beyond MinClassSize are
+	 * owned by upstream and must still be deallocated individually.
+	 */
+	void Release() {
+		while (slabs) {
+			Slab* next = slabs->next;
+			upstream->Deallocate(slabs, slabSize);
+			slabs = next;
+		}
+		for (int i = 0; i < ClassCount; ++i)
+			freeLists[i] = nullptr;
+	}
+
+private:
+	struct FreeBlock {
+		FreeBlock* next;  ///< Next free block of the same class
+	};
+
+	/**
+	 * @brief Header of a slab; padded so carved blocks stay 16-byte aligned
+	 */
+	struct alignas(16) Slab {
+		Slab* next;  ///< Previously allocated slab
+	};
+
+	/**
+	 * @brief Whether a request is served from the size classes or by upstream
+	 */
+	static bool Pooled(size_t bytes, size_t alignment) {
+		return bytes <= MaxPooledSize && alignment <= MinClassSize;
+	}
+
+	static int SizeClass(size_t bytes) {
+		int c = 0;
+		size_t size = MinClassSize;
+		while (size < bytes) {
+			size <<= 1;
+			++c;
+		}
+		return c;
+	}
+
+	void Refill(int c) {
+		Slab* slab = (Slab*)upstream->Allocate(slabSize);
+		slab->next = slabs;
+		slabs = slab;
+
+		size_t blockSize = MinClassSize << c;
+		char* begin = (char*)(slab + 1);
+		char* end = (char*)slab + slabSize;
+		for (char* p = begin; p + blockSize <= end; p += blockSize) {
+			FreeBlock* block = (FreeBlock*)p;
+			block->next = freeLists[c];
+			freeLists[c] = block;
+		}
+	}
+
+	FreeBlock* freeLists[ClassCount];  ///< Free list head per size class
+	Slab* slabs;                       ///< All slabs taken from upstream
+	size_t slabSize;                   ///< Size of each slab
+	Allocator* upstream;               ///< Source of the slabs and large blocks
+};
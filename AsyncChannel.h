@@ -0,0 +1,447 @@
+/**
+ * @file AsyncChannel.h
+ * @brief Bounded channel whose Push/Pop are C++20 coroutine awaitables
+ *
+ * Lets pipeline stages be written as coroutines that suspend instead of
+ * blocking an OS thread: co_await channel.Pop() suspends while the channel
+ * is empty and co_await channel.Push(x) suspends while it is full. Woken
+ * coroutines are resumed through an Executor, either on a single thread or
+ * on a small pool, so many stages can share a few threads.
+ *
+ * Features:
+ * - Elements stored in a Queue ring buffer, capped at a fixed capacity
+ * - Direct hand-off to a suspended popper, no round trip through the ring
+ * - Close() to end a pipeline: pending and later pops return empty
+ * - SingleThreadExecutor and ThreadPoolExecutor
+ *
+ * Requires C++20 (-std=c++20).
+ */
+
+// filepath: e:\Playground\AsyncChannel.h
+#pragma once
+#include "Queue.h"
+#include <coroutine>
+#include <optional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <assert.h>
+
+/**
+ * @class AsyncTask
+ * @brief Fire-and-forget coroutine handed to an Executor
+ *
+ * A coroutine returning AsyncTask does not start until it is spawned on an
+ * executor, and its frame is destroyed automatically when it returns.
+ */
+class AsyncTask {
+public:
+	struct promise_type {
+		AsyncTask get_return_object() {
+			return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+
+	AsyncTask(AsyncTask&& other) noexcept
+		: handle(other.handle)
+	{
+		other.handle = nullptr;
+	}
+
+	AsyncTask(const AsyncTask&) = delete;
+	AsyncTask& operator=(const AsyncTask&) = delete;
+
+	/**
+	 * @brief Destroys a task that was never spawned
+	 */
+	~AsyncTask() {
+		if (handle)
+			handle.destroy();
+	}
+
+	/**
+	 * @brief Gives up ownership of the (not yet started) coroutine
+	 */
+	std::coroutine_handle<> Release() {
+		std::coroutine_handle<> h = handle;
+		handle = nullptr;
+		return h;
+	}
+
+private:
+	explicit AsyncTask(std::coroutine_handle<promise_type> handle)
+		: handle(handle)
+	{
+	}
+
+	std::coroutine_handle<promise_type> handle;  ///< Suspended at its initial suspend point
+};
+
+/**
+ * @class Executor
+ * @brief Something that resumes coroutine handles
+ */
+class Executor {
+public:
+	virtual ~Executor() {}
+
+	/**
+	 * @brief Queues a suspended coroutine to be resumed
+	 */
+	virtual void Schedule(std::coroutine_handle<> handle) = 0;
+
+	/**
+	 * @brief Starts a task on this executor
+	 */
+	void Spawn(AsyncTask task) {
+		Schedule(task.Release());
+	}
+};
+
+/**
+ * @class SingleThreadExecutor
+ * @brief Runs every coroutine on the thread that calls Run()
+ *
+ * Not thread-safe: only coroutines running on this executor (or the
+ * owning thread) may schedule onto it.
+ */
+class SingleThreadExecutor : public Executor {
+public:
+	void Schedule(std::coroutine_handle<> handle) override {
+		ready.push_back(handle);
+	}
+
+	/**
+	 * @brief Resumes ready coroutines until none is left
+	 */
+	void Run() {
+		while (!ready.empty()) {
+			std::coroutine_handle<> handle = ready.front();
+			ready.pop_front();
+			handle.resume();
+		}
+	}
+
+private:
+	std::deque<std::coroutine_handle<>> ready;  ///< Coroutines waiting to be resumed
+};
+
+/**
+ * @class ThreadPoolExecutor
+ * @brief Resumes coroutines on a fixed set of worker threads
+ */
+class ThreadPoolExecutor : public Executor {
+public:
+	/**
+	 * @brief Starts the workers
+	 * @param threads Number of workers (hardware concurrency if 0)
+	 */
+	explicit ThreadPoolExecutor(int threads = 0) {
+		if (threads <= 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		for (int i = 0; i < threads; ++i)
+			workers.emplace_back(&ThreadPoolExecutor::WorkerLoop, this);
+	}
+
+	/**
+	 * @brief Destructor - stops and joins the workers
+	 *
+	 * Coroutines still suspended in channels are not destroyed.
+	 */
+	~ThreadPoolExecutor() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wakeup.notify_all();
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	void Schedule(std::coroutine_handle<> handle) override {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			ready.push_back(handle);
+		}
+		wakeup.notify_one();
+	}
+
+	/**
+	 * @brief Blocks until no coroutine is ready or running
+	 */
+	void WaitIdle() {
+		std::unique_lock<std::mutex> lock(mutex);
+		idle.wait(lock, [this] { return ready.empty() && running == 0; });
+	}
+
+private:
+	void WorkerLoop() {
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;) {
+			wakeup.wait(lock, [this] { return stopping || !ready.empty(); });
+			if (ready.empty())
+				return;
+			std::coroutine_handle<> handle = ready.front();
+			ready.pop_front();
+			running += 1;
+			lock.unlock();
+			handle.resume();
+			lock.lock();
+			running -= 1;
+			if (ready.empty() && running == 0)
+				idle.notify_all();
+		}
+	}
+
+	std::vector<std::thread> workers;           ///< Worker threads
+	std::mutex mutex;                           ///< Guards everything below
+	std::condition_variable wakeup;             ///< Workers wait for ready coroutines
+	std::condition_variable idle;               ///< WaitIdle() waits here
+	std::deque<std::coroutine_handle<>> ready;  ///< Coroutines waiting to be resumed
+	int running = 0;                            ///< Coroutines being resumed right now
+	bool stopping = false;                      ///< Set by the destructor
+};
+
+/**
+ * @class AsyncChannel
+ * @brief Bounded FIFO of integers for coroutines
+ *
+ * Suspended coroutines wait in intrusive FIFO lists threaded through
+ * their awaiters, which live in the coroutine frames, so suspending never
+ * allocates. Every state change happens under one mutex; coroutines that
+ * become runnable are scheduled on the executor after it is released.
+ *
+ * Typical stage:
+ *
+ *     AsyncTask stage(AsyncChannel& in, AsyncChannel& out) {
+ *         while (std::optional<int> x = co_await in.Pop())
+ *             co_await out.Push(*x * 2);
+ *         out.Close();
+ *     }
+ */
+class AsyncChannel {
+	/**
+	 * @brief State of one suspended (or about to suspend) Push/Pop
+	 */
+	struct Waiter {
+		std::coroutine_handle<> handle;  ///< Coroutine to resume
+		Waiter* next = nullptr;          ///< Next waiter in the list
+		int value = 0;                   ///< Value to push, or the popped value
+		bool ok = false;                 ///< Operation completed (false: channel closed)
+	};
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param executor Executor that resumes coroutines woken by this channel
+	 * @param capacity Maximum number of buffered elements (at least 1)
+	 * @param allocator Allocator used for the ring storage (heap if null)
+	 */
+	AsyncChannel(Executor& executor, int capacity, Allocator* allocator = nullptr)
+		: executor(executor), capacity(capacity), queue(allocator)
+	{
+		if (capacity < 1)
+			assert(false);
+	}
+
+	AsyncChannel(const AsyncChannel&) = delete;
+	AsyncChannel& operator=(const AsyncChannel&) = delete;
+
+	/**
+	 * @brief Awaitable returned by Push(); yields false if the channel was closed
+	 */
+	class PushAwaiter {
+	public:
+		bool await_ready() const noexcept { return false; }
+		bool await_suspend(std::coroutine_handle<> handle) { return channel.SuspendPush(waiter, handle); }
+		bool await_resume() const noexcept { return waiter.ok; }
+
+	private:
+		friend class AsyncChannel;
+		PushAwaiter(AsyncChannel& channel, int value)
+			: channel(channel)
+		{
+			waiter.value = value;
+		}
+
+		AsyncChannel& channel;
+		Waiter waiter;
+	};
+
+	/**
+	 * @brief Awaitable returned by Pop(); yields nothing once the channel is closed and drained
+	 */
+	class PopAwaiter {
+	public:
+		bool await_ready() const noexcept { return false; }
+		bool await_suspend(std::coroutine_handle<> handle) { return channel.SuspendPop(waiter, handle); }
+		std::optional<int> await_resume() const noexcept {
+			return waiter.ok ? std::optional<int>(waiter.value) : std::nullopt;
+		}
+
+	private:
+		friend class AsyncChannel;
+		explicit PopAwaiter(AsyncChannel& channel)
+			: channel(channel)
+		{
+		}
+
+		AsyncChannel& channel;
+		Waiter waiter;
+	};
+
+	/**
+	 * @brief Sends an element: co_await channel.Push(x)
+	 * @param value The element
+	 * @return Awaitable; suspends while the channel is full
+	 */
+	PushAwaiter Push(int value) {
+		return PushAwaiter(*this, value);
+	}
+
+	/**
+	 * @brief Receives the oldest element: co_await channel.Pop()
+	 * @return Awaitable; suspends while the channel is empty and open
+	 */
+	PopAwaiter Pop() {
+		return PopAwaiter(*this);
+	}
+
+	/**
+	 * @brief Closes the channel
+	 *
+	 * Buffered elements can still be popped. Suspended pushers resume with
+	 * false, suspended poppers with an empty optional, and so do all later
+	 * Push() and Pop() calls once the buffer is drained.
+	 */
+	void Close() {
+		Waiter* woken;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			closed = true;
+			woken = poppers.first;
+			Waiter* last = poppers.last;
+			if (last)
+				last->next = pushers.first;
+			else
+				woken = pushers.first;
+			poppers = WaitList();
+			pushers = WaitList();
+		}
+		while (woken) {
+			Waiter* next = woken->next;
+			woken->ok = false;
+			executor.Schedule(woken->handle);
+			woken = next;
+		}
+	}
+
+	/**
+	 * @brief Returns the number of buffered elements (a snapshot)
+	 */
+	int Size() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return queue.Size();
+	}
+
+private:
+	/**
+	 * @brief Intrusive FIFO of waiters
+	 */
+	struct WaitList {
+		Waiter* first = nullptr;
+		Waiter* last = nullptr;
+
+		void PushBack(Waiter* waiter) {
+			waiter->next = nullptr;
+			if (last)
+				last->next = waiter;
+			else
+				first = waiter;
+			last = waiter;
+		}
+
+		Waiter* PopFront() {
+			Waiter* waiter = first;
+			if (waiter) {
+				first = waiter->next;
+				if (!first)
+					last = nullptr;
+			}
+			return waiter;
+		}
+	};
+
+	/**
+	 * @brief Completes a push now or parks the coroutine
+	 * @return true to stay suspended, false to continue immediately
+	 */
+	bool SuspendPush(Waiter& waiter, std::coroutine_handle<> handle) {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (closed) {
+			waiter.ok = false;
+			return false;
+		}
+		if (Waiter* popper = poppers.PopFront()) {
+			// Only possible while the buffer is empty: hand the value over directly
+			popper->value = waiter.value;
+			popper->ok = true;
+			lock.unlock();
+			executor.Schedule(popper->handle);
+			waiter.ok = true;
+			return false;
+		}
+		if (queue.Size() < capacity) {
+			queue.Push(waiter.value);
+			waiter.ok = true;
+			return false;
+		}
+		waiter.handle = handle;
+		pushers.PushBack(&waiter);
+		return true;
+	}
+
+	/**
+	 * @brief Completes a pop now or parks the coroutine
+	 * @return true to stay suspended, false to continue immediately
+	 */
+	bool SuspendPop(Waiter& waiter, std::coroutine_handle<> handle) {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!queue.IsEmpty()) {
+			waiter.value = queue.Back();
+			queue.Pop();
+			waiter.ok = true;
+			// The freed slot goes to the longest-waiting pusher
+			if (Waiter* pusher = pushers.PopFront()) {
+				queue.Push(pusher->value);
+				pusher->ok = true;
+				lock.unlock();
+				executor.Schedule(pusher->handle);
+			}
+			return false;
+		}
+		if (closed) {
+			waiter.ok = false;
+			return false;
+		}
+		waiter.handle = handle;
+		poppers.PushBack(&waiter);
+		return true;
+	}
+
+	Executor& executor;  ///< Resumes woken coroutines
+	int capacity;        ///< Maximum buffered elements
+	std::mutex mutex;    ///< Guards everything below
+	Queue queue;         ///< Buffered elements
+	WaitList pushers;    ///< Coroutines waiting for room
+	WaitList poppers;    ///< Coroutines waiting for an element
+	bool closed = false; ///< Close() was called
+};
@@ -0,0 +1,223 @@
+/**
+ * @file EpochReclamation.h
+ * @brief Epoch-based safe memory reclamation for lock-free structures
+ *
+ * Lock-free containers cannot free a node as soon as it is unlinked,
+ * because another thread may still be reading it. Epoch-based reclamation
+ * defers the free until every thread has moved past the epoch in which the
+ * node was retired.
+ *
+ * Features:
+ * - RAII EpochGuard marking a thread as inside a critical section
+ * - Retire() defers destruction of unlinked nodes
+ * - Per-thread retire lists, no locks on the fast path
+ */
+
+// filepath: e:\Playground\EpochReclamation.h
+#pragma once
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+#include <stdint.h>
+
+/**
+ * @class EpochDomain
+ * @brief Process-wide epoch state shared by every lock-free structure
+ *
+ * Each thread owns one record holding the epoch it entered at and three
+ * retire buckets. A node is labelled with the global epoch e current when
+ * it was retired and can be freed once the global epoch reaches e + 2,
+ * because by then every thread has left any critical section that could
+ * have seen it. The global epoch only advances when every active thread
+ * has observed the current one.
+ */
+class EpochDomain {
+public:
+	static const int MaxThreads = 256;         ///< Concurrently registered threads
+	static const int AdvanceThreshold = 64;    ///< Retires between advance attempts
+
+	typedef void (*Deleter)(void*);
+
+	/**
+	 * @brief Returns the shared domain
+	 */
+	static EpochDomain& Instance() {
+		static EpochDomain domain;
+		return domain;
+	}
+
+	~EpochDomain() {
+		for (int i = 0; i < MaxThreads; ++i)
+			for (int b = 0; b < 3; ++b)
+				FreeBucket(records[i], b);
+	}
+
+	/**
+	 * @brief Marks the calling thread as inside a critical section
+	 *
+	 * Guards may nest; only the outermost one publishes the epoch.
+	 */
+	void Enter() {
+		Record& record = Local();
+		if (record.depth++ > 0)
+			return;
+		uint64_t epoch = globalEpoch.load(std::memory_order_relaxed);
+		record.epoch.store(epoch, std::memory_order_relaxed);
+		record.active.store(true, std::memory_order_seq_cst);
+		epoch = globalEpoch.load(std::memory_order_seq_cst);
+		record.epoch.store(epoch, std::memory_order_seq_cst);
+		Collect(record, epoch);
+	}
+
+	/**
+	 * @brief Marks the calling thread as outside any critical section
+	 */
+	void Exit() {
+		Record& record = Local();
+		if (--record.depth > 0)
+			return;
+		record.active.store(false, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Defers destruction of an unlinked object
+	 * @param object Object no longer reachable from the shared structure
+	 * @param deleter Function that destroys it once it is safe
+	 *
+	 * Must be called inside a critical section.
+	 */
+	void Retire(void* object, Deleter deleter) {
+		// Label with the global epoch read after the unlink, not the epoch
+		// this thread entered at: a reader that entered later may still hold it.
+		Record& record = Local();
+		uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+		int b = epoch % 3;
+		if (record.bucketEpoch[b] != epoch) {
+			FreeBucket(record, b);
+			record.bucketEpoch[b] = epoch;
+		}
+		record.retired[b].push_back(Retired{object, deleter});
+		if (++record.retiresSinceAdvance >= AdvanceThreshold) {
+			record.retiresSinceAdvance = 0;
+			TryAdvance(epoch);
+		}
+	}
+
+private:
+	struct Retired {
+		void* object;     ///< Unlinked object
+		Deleter deleter;  ///< Destroys the object
+	};
+
+	/**
+	 * @brief Per-thread state, one cache line of hot fields per thread
+	 */
+	struct alignas(64) Record {
+		std::atomic<uint64_t> epoch{0};       ///< Epoch observed on entry
+		std::atomic<bool> active{false};      ///< Inside a critical section
+		std::atomic<bool> owned{false};       ///< Claimed by a live thread
+		int depth = 0;                        ///< Guard nesting depth
+		int retiresSinceAdvance = 0;          ///< Retires since last advance attempt
+		uint64_t bucketEpoch[3] = {0, 0, 0};  ///< Epoch of the objects in each bucket
+		std::vector<Retired> retired[3];      ///< Retire buckets indexed by epoch % 3
+	};
+
+	/**
+	 * @brief Releases the thread's record when the thread exits
+	 */
+	struct Registration {
+		Record* record = nullptr;
+		~Registration() {
+			if (record)
+				record->owned.store(false, std::memory_order_release);
+		}
+	};
+
+	EpochDomain() : globalEpoch(2) {}
+
+	/**
+	 * @brief Record of the calling thread, claimed on first use
+	 *
+	 * Throws std::length_error when MaxThreads threads already hold a
+	 * record, in release builds too.
+	 */
+	Record& Local() {
+		static thread_local Registration registration;
+		if (!registration.record)
+			registration.record = Claim();
+		return *registration.record;
+	}
+
+	Record* Claim() {
+		for (int i = 0; i < MaxThreads; ++i) {
+			bool expected = false;
+			if (!records[i].owned.load(std::memory_order_relaxed)
+				&& records[i].owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				return &records[i];
+		}
+		throw std::length_error("too many threads registered with EpochDomain");
+	}
+
+	/**
+	 * @brief Frees buckets whose epoch is at least two behind the current one
+	 */
+	void Collect(Record& record, uint64_t epoch) {
+		for (int b = 0; b < 3; ++b)
+			if (record.bucketEpoch[b] + 2 <= epoch)
+				FreeBucket(record, b);
+	}
+
+	void FreeBucket(Record& record, int b) {
+		for (Retired& r : record.retired[b])
+			r.deleter(r.object);
+		record.retired[b].clear();
+	}
+
+	/**
+	 * @brief Advances the global epoch if every active thread has caught up
+	 */
+	void TryAdvance(uint64_t epoch) {
+		// Acquire pairs with the release in Exit(), so everything a thread
+		// read in its critical section happens before the objects are freed.
+		for (int i = 0; i < MaxThreads; ++i) {
+			Record& other = records[i];
+			if (other.active.load(std::memory_order_seq_cst)
+				&& other.epoch.load(std::memory_order_seq_cst) != epoch)
+				return;
+		}
+		globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+	}
+
+	std::atomic<uint64_t> globalEpoch;  ///< Current global epoch
+	Record records[MaxThreads];         ///< One record per registered thread
+};
+
+/**
+ * @class EpochGuard
+ * @brief RAII critical section for EpochDomain
+ *
+ * Any pointer read from a shared lock-free structure stays valid until
+ * the guard that was active when it was read goes out of scope.
+ */
+class EpochGuard {
+public:
+	EpochGuard() {
+		EpochDomain::Instance().Enter();
+	}
+
+	~EpochGuard() {
+		EpochDomain::Instance().Exit();
+	}
+
+	EpochGuard(const EpochGuard&) = delete;
+	EpochGuard& operator=(const EpochGuard&) = delete;
+
+	/**
+	 * @brief Retires an object allocated with new
+	 * @param object Object already unlinked from the shared structure
+	 */
+	template<typename T>
+	void Retire(T* object) {
+		EpochDomain::Instance().Retire(object, [](void* p) { delete (T*)p; });
+	}
+};
@@ -0,0 +1,263 @@
+/**
+ * @file IndexedPriorityQueue.h
+ * @brief Indexed d-ary min-heap with decrease-key
+ *
+ * A priority queue over item ids 0..capacity-1 that remembers where every
+ * id sits in the heap, so the key of an item already in the queue can be
+ * changed or the item removed without searching for it. This is what
+ * Dijkstra, Prim and event schedulers need.
+ *
+ * Features:
+ * - Push/Pop/DecreaseKey/IncreaseKey/Erase in O(log n), Top in O(1)
+ * - d-ary layout (4 by default): shallower tree, children of a slot are contiguous
+ * - Ids and keys kept in separate arrays so sift-down scans only keys
+ * - Position map from id to heap slot
+ */
+
+// filepath: e:\Playground\IndexedPriorityQueue.h
+#pragma once
+#include <vector>
+#include <assert.h>
+
+/**
+ * @class IndexedPriorityQueue
+ * @brief Min-heap of (id, key) pairs addressable by id
+ * @tparam Key Priority type; smaller keys come out first
+ * @tparam Arity Children per heap node
+ *
+ * keys[i] and ids[i] describe heap slot i, and position[id] is the slot of
+ * id (or -1 if absent). Sifting moves a hole instead of swapping, so each
+ * level costs one key/id write plus one position update.
+ */
+template<typename Key = int, int Arity = 4>
+class IndexedPriorityQueue {
+	static_assert(Arity >= 2, "IndexedPriorityQueue needs at least two children per node");
+
+public:
+	/**
+	 * @brief Constructor - creates an empty queue
+	 * @param capacity Number of distinct ids; valid ids are 0..capacity-1
+	 */
+	explicit IndexedPriorityQueue(int capacity)
+		: position(capacity, -1)
+	{
+		ids.reserve(capacity);
+		keys.reserve(capacity);
+	}
+
+	/**
+	 * @brief Inserts an id that is not in the queue yet
+	 * @param id Item id
+	 * @param key Its priority
+	 *
+	 * Time complexity: O(log n)
+	 */
+	void Push(int id, Key key) {
+		if (Contains(id))
+			assert(false);
+		ids.push_back(id);
+		keys.push_back(key);
+		SiftUp((int)ids.size() - 1, id, key);
+	}
+
+	/**
+	 * @brief Returns the id with the smallest key
+	 *
+	 * Asserts if the queue is empty.
+	 */
+	int Top() const {
+		if (ids.empty())
+			assert(false);
+		return ids[0];
+	}
+
+	/**
+	 * @brief Returns the smallest key
+	 *
+	 * Asserts if the queue is empty.
+	 */
+	Key TopKey() const {
+		if (ids.empty())
+			assert(false);
+		return keys[0];
+	}
+
+	/**
+	 * @brief Removes the id with the smallest key
+	 *
+	 * Time complexity: O(d log_d n)
+	 */
+	void Pop() {
+		if (ids.empty())
+			return;
+		RemoveAt(0);
+	}
+
+	/**
+	 * @brief Lowers the key of an id in the queue
+	 * @param id Item id
+	 * @param key New key, not larger than the current one
+	 *
+	 * Time complexity: O(log_d n)
+	 */
+	void DecreaseKey(int id, Key key) {
+		int slot = SlotOf(id);
+		if (keys[slot] < key)
+			assert(false);
+		SiftUp(slot, id, key);
+	}
+
+	/**
+	 * @brief Raises the key of an id in the queue
+	 * @param id Item id
+	 * @param key New key, not smaller than the current one
+	 *
+	 * Time complexity: O(d log_d n)
+	 */
+	void IncreaseKey(int id, Key key) {
+		int slot = SlotOf(id);
+		if (key < keys[slot])
+			assert(false);
+		SiftDown(slot, id, key);
+	}
+
+	/**
+	 * @brief Sets the key of an id, inserting it if absent
+	 * @param id Item id
+	 * @param key New key
+	 */
+	void Update(int id, Key key) {
+		if (!Contains(id))
+			Push(id, key);
+		else if (key < keys[position[id]])
+			SiftUp(position[id], id, key);
+		else
+			SiftDown(position[id], id, key);
+	}
+
+	/**
+	 * @brief Removes an id from the queue
+	 * @param id Item id; nothing happens if it is not in the queue
+	 *
+	 * Time complexity: O(d log_d n)
+	 */
+	void Erase(int id) {
+		if (Contains(id))
+			RemoveAt(position[id]);
+	}
+
+	/**
+	 * @brief Checks if an id is in the queue
+	 */
+	bool Contains(int id) const {
+		if (id < 0 || id >= (int)position.size())
+			assert(false);
+		return position[id] >= 0;
+	}
+
+	/**
+	 * @brief Returns the key of an id in the queue
+	 */
+	Key KeyOf(int id) const {
+		return keys[SlotOf(id)];
+	}
+
+	/**
+	 * @brief Removes every id
+	 *
+	 * Time complexity: O(n) in the number of queued ids
+	 */
+	void Clear() {
+		for (int id : ids)
+			position[id] = -1;
+		ids.clear();
+		keys.clear();
+	}
+
+	/**
+	 * @brief Returns the number of queued ids
+	 */
+	int Size() const {
+		return (int)ids.size();
+	}
+
+	/**
+	 * @brief Checks if the queue is empty
+	 */
+	bool IsEmpty() const {
+		return ids.empty();
+	}
+
+private:
+	int SlotOf(int id) const {
+		if (!Contains(id))
+			assert(false);
+		return position[id];
+	}
+
+	/**
+	 * @brief Moves the last entry into slot and restores the heap order
+	 */
+	void RemoveAt(int slot) {
+		position[ids[slot]] = -1;
+		int lastId = ids.back();
+		Key lastKey = keys.back();
+		ids.pop_back();
+		keys.pop_back();
+		if (slot == (int)ids.size())
+			return;
+		if (slot > 0 && lastKey < keys[(slot - 1) / Arity])
+			SiftUp(slot, lastId, lastKey);
+		else
+			SiftDown(slot, lastId, lastKey);
+	}
+
+	/**
+	 * @brief Places (id, key) at or above the hole at slot
+	 */
+	void SiftUp(int slot, int id, Key key) {
+		while (slot > 0) {
+			int parent = (slot - 1) / Arity;
+			if (!(key < keys[parent]))
+				break;
+			Place(slot, ids[parent], keys[parent]);
+			slot = parent;
+		}
+		Place(slot, id, key);
+	}
+
+	/**
+	 * @brief Places (id, key) at or below the hole at slot
+	 *
+	 * The children of a slot are adjacent in keys, so finding the smallest
+	 * one is a short linear scan over one or two cache lines.
+	 */
+	void SiftDown(int slot, int id, Key key) {
+		int n = (int)keys.size();
+		for (;;) {
+			int first = slot * Arity + 1;
+			if (first >= n)
+				break;
+			int last = first + Arity < n ? first + Arity : n;
+			int best = first;
+			for (int child = first + 1; child < last; ++child)
+				if (keys[child] < keys[best])
+					best = child;
+			if (!(keys[best] < key))
+				break;
+			Place(slot, ids[best], keys[best]);
+			slot = best;
+		}
+		Place(slot, id, key);
+	}
+
+	void Place(int slot, int id, Key key) {
+		ids[slot] = id;
+		keys[slot] = key;
+		position[id] = slot;
+	}
+
+	std::vector<int> ids;       ///< Id stored in each heap slot
+	std::vector<Key> keys;      ///< Key stored in each heap slot
+	std::vector<int> position;  ///< Heap slot of each id, -1 if absent
+};
@@ -0,0 +1,187 @@
+/**
+ * @file LockFreeStack.h
+ * @brief Lock-free concurrent stack (Treiber stack with elimination)
+ *
+ * A LIFO that any number of threads can push to and pop from without
+ * locks, intended for shared free lists and work stacks.
+ *
+ * Features:
+ * - Treiber stack: a single CAS on the head publishes each push/pop
+ * - ABA protection through a version tag packed into the head word
+ * - Epoch-based reclamation so popped nodes are freed safely
+ * - Elimination-backoff array that pairs up pushes and pops under contention
+ *
+ * Requires 64-bit pointers with at most 48 significant bits (x86-64, AArch64).
+ */
+
+// filepath: e:\Playground\LockFreeStack.h
+#pragma once
+#include "EpochReclamation.h"
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @class LockFreeStack
+ * @brief Concurrent LIFO of integers
+ *
+ * The head is a 64-bit word holding the top node pointer in its low 48
+ * bits and a 16-bit version in the high bits; every successful CAS bumps
+ * the version, so a head that was popped and re-pushed in between is not
+ * mistaken for the one originally read. Nodes are retired through
+ * EpochDomain, which also keeps addresses from being reused while any
+ * thread may still compare against them.
+ *
+ * When a CAS on the head fails, the thread backs off into a random slot of
+ * the elimination array: a pusher parks its node there for a short while
+ * and a popper that finds a node takes it directly, so the pair completes
+ * without touching the head at all.
+ */
+class LockFreeStack {
+public:
+	static const int EliminationSlots = 16;  ///< Size of the elimination array
+	static const int EliminationSpins = 64;  ///< How long a pusher waits for a partner
+
+	LockFreeStack()
+		: head(0)
+	{
+		for (int i = 0; i < EliminationSlots; ++i)
+			elimination[i].node.store(nullptr, std::memory_order_relaxed);
+	}
+
+	LockFreeStack(const LockFreeStack&) = delete;
+	LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+	/**
+	 * @brief Destructor - frees the remaining nodes
+	 *
+	 * No other thread may be using the stack.
+	 */
+	~LockFreeStack() {
+		Node* node = Pointer(head.load(std::memory_order_relaxed));
+		while (node) {
+			Node* next = node->next;
+			delete node;
+			node = next;
+		}
+	}
+
+	/**
+	 * @brief Pushes an element onto the stack
+	 * @param data The element to push
+	 *
+	 * Lock-free: some thread always completes in a bounded number of steps.
+	 */
+	void Push(int data) {
+		Node* node = new Node{data, nullptr};
+		EpochGuard guard;
+		for (;;) {
+			uint64_t top = head.load(std::memory_order_relaxed);
+			node->next = Pointer(top);
+			if (head.compare_exchange_weak(top, Pack(node, Tag(top) + 1),
+				std::memory_order_release, std::memory_order_relaxed))
+				return;
+			if (TryEliminatePush(node))
+				return;
+		}
+	}
+
+	/**
+	 * @brief Pops the top element
+	 * @param data Receives the popped element
+	 * @return false if the stack was empty
+	 */
+	bool TryPop(int& data) {
+		EpochGuard guard;
+		for (;;) {
+			uint64_t top = head.load(std::memory_order_acquire);
+			Node* node = Pointer(top);
+			if (!node)
+				return false;
+			if (head.compare_exchange_weak(top, Pack(node->next, Tag(top) + 1),
+				std::memory_order_acquire, std::memory_order_relaxed)) {
+				data = node->value;
+				guard.Retire(node);
+				return true;
+			}
+			if (TryEliminatePop(data, guard))
+				return true;
+		}
+	}
+
+	/**
+	 * @brief Checks if the stack is empty
+	 * @return A snapshot; may be stale as soon as it is returned
+	 */
+	bool IsEmpty() const {
+		return Pointer(head.load(std::memory_order_acquire)) == nullptr;
+	}
+
+private:
+	struct Node {
+		int value;   ///< Stored element
+		Node* next;  ///< Node below this one
+	};
+
+	/**
+	 * @brief Elimination slot padded to its own cache line
+	 */
+	struct alignas(64) Exchanger {
+		std::atomic<Node*> node;  ///< Node offered by a pusher, or null
+	};
+
+	static const int TagShift = 48;
+	static const uint64_t PointerMask = (1ULL << TagShift) - 1;
+
+	static Node* Pointer(uint64_t word) {
+		return (Node*)(uintptr_t)(word & PointerMask);
+	}
+
+	static uint64_t Tag(uint64_t word) {
+		return word >> TagShift;
+	}
+
+	static uint64_t Pack(Node* node, uint64_t tag) {
+		return ((uint64_t)(uintptr_t)node & PointerMask) | (tag << TagShift);
+	}
+
+	/**
+	 * @brief Offers a node in a random slot and waits briefly for a popper
+	 * @return true if a popper took the node
+	 */
+	bool TryEliminatePush(Node* node) {
+		Exchanger& slot = elimination[RandomSlot()];
+		Node* expected = nullptr;
+		if (!slot.node.compare_exchange_strong(expected, node, std::memory_order_release))
+			return false;
+		for (int spin = 0; spin < EliminationSpins; ++spin)
+			if (slot.node.load(std::memory_order_relaxed) != node)
+				return true;
+		expected = node;
+		return !slot.node.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Takes a node offered by a concurrent pusher, if any
+	 * @return true if a node was taken and its value stored in data
+	 */
+	bool TryEliminatePop(int& data, EpochGuard& guard) {
+		Exchanger& slot = elimination[RandomSlot()];
+		Node* node = slot.node.load(std::memory_order_acquire);
+		if (!node || !slot.node.compare_exchange_strong(node, nullptr, std::memory_order_acquire))
+			return false;
+		data = node->value;
+		guard.Retire(node);
+		return true;
+	}
+
+	static int RandomSlot() {
+		static thread_local uint32_t state = (uint32_t)(uintptr_t)&state | 1;
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state % EliminationSlots;
+	}
+
+	alignas(64) std::atomic<uint64_t> head;  ///< Tagged pointer to the top node
+	Exchanger elimination[EliminationSlots]; ///< Elimination-backoff array
+};
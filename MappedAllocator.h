@@ -0,0 +1,231 @@
+/**
+ * @file MappedAllocator.h
+ * @brief Virtual-memory backed allocator for very large arrays
+ *
+ * Backs each block with its own mmap region so that growing a block is a
+ * page-table operation (mremap) instead of allocate + memcpy + free. This
+ * keeps peak memory at the size of the array while it grows.
+ *
+ * Features:
+ * - Anonymous MAP_NORESERVE mappings, grown in place through mremap
+ * - Transparent huge pages requested with madvise
+ * - Optional file backing: the block survives the process and can be
+ *   reopened without reloading the data
+ *
+ * Linux only (relies on mremap and MADV_HUGEPAGE).
+ */
+
+// filepath: e:\Playground\MappedAllocator.h
+#pragma once
+#include "Allocator.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+/**
+ * @class MappedAllocator
+ * @brief Allocator that gives every block its own memory mapping
+ *
+ * In anonymous mode any number of blocks may be live at once. In file mode
+ * the allocator manages a single block stored in the file after a one-page
+ * header recording how many bytes are in use; a Vector constructed with the
+ * allocator reopens that block with its previous contents.
+ *
+ * Usage:
+ *   MappedAllocator huge;                  // anonymous, grows via mremap
+ *   Vector big(&huge);
+ *
+ *   MappedAllocator file("ids.bin");       // persistent
+ *   Vector ids(&file);                     // reopens previous contents
+ */
+class MappedAllocator : public Allocator {
+public:
+	/**
+	 * @brief Constructs an allocator producing anonymous mappings
+	 * @param hugePages Request transparent huge pages for every mapping
+	 */
+	explicit MappedAllocator(bool hugePages = true)
+		: fd(-1), mapping(nullptr), hugePages(hugePages)
+	{
+	}
+
+	/**
+	 * @brief Constructs an allocator backed by a file
+	 * @param path File holding the block; created if it does not exist
+	 * @param hugePages Request transparent huge pages for the mapping
+	 *
+	 * Throws std::system_error if the file cannot be opened.
+	 */
+	explicit MappedAllocator(const char* path, bool hugePages = true)
+		: fd(-1), mapping(nullptr), hugePages(hugePages)
+	{
+		fd = open(path, O_RDWR | O_CREAT, 0644);
+		if (fd < 0)
+			throw std::system_error(errno, std::generic_category(), path);
+	}
+
+	MappedAllocator(const MappedAllocator&) = delete;
+	MappedAllocator& operator=(const MappedAllocator&) = delete;
+
+	~MappedAllocator() {
+		if (fd >= 0)
+			close(fd);
+	}
+
+	/**
+	 * @brief Maps a fresh region of at least the requested size
+	 *
+	 * Anonymous regions use MAP_NORESERVE, so untouched pages cost nothing.
+	 * Alignment is always at least the page size. A file-backed allocator
+	 * holds a single block and throws std::logic_error while it is mapped.
+	 */
+	void* Allocate(size_t bytes, size_t /*alignment*/ = alignof(max_align_t)) override {
+		if (fd < 0)
+			return MapAnonymous(PageRound(bytes));
+
+		if (mapping)
+			throw std::logic_error("a file-backed MappedAllocator holds a single block");
+		size_t length = HeaderSize + PageRound(bytes);
+		Resize(length);
+		mapping = MapFile(length);
+		Header* header = (Header*)mapping;
+		header->magic = Magic;
+		header->usedBytes = 0;
+		return mapping + HeaderSize;
+	}
+
+	/**
+	 * @brief Unmaps a block; file-backed data stays in the file
+	 */
+	void Deallocate(void* block, size_t bytes, size_t /*alignment*/ = alignof(max_align_t)) override {
+		if (fd < 0) {
+			munmap(block, PageRound(bytes));
+			return;
+		}
+		munmap(mapping, HeaderSize + PageRound(bytes));
+		mapping = nullptr;
+	}
+
+	/**
+	 * @brief Grows or shrinks a block through mremap without copying data
+	 *
+	 * The kernel moves page-table entries when the region cannot be
+	 * extended in place, so no element is copied at any size.
+	 */
+	void* Reallocate(void* block, size_t oldBytes, size_t newBytes, size_t /*usedBytes*/) override {
+		if (!block)
+			return Allocate(newBytes);
+
+		if (fd < 0)
+			return Remap(block, PageRound(oldBytes), PageRound(newBytes));
+
+		size_t oldLength = HeaderSize + PageRound(oldBytes);
+		size_t newLength = HeaderSize + PageRound(newBytes);
+		if (newLength > oldLength)
+			Resize(newLength);
+		mapping = Remap(mapping, oldLength, newLength);
+		if (newLength < oldLength)
+			Resize(newLength);
+		return mapping + HeaderSize;
+	}
+
+	/**
+	 * @brief Reopens the block stored in the backing file, if any
+	 *
+	 * Returns null in anonymous mode or when the file is empty or was not
+	 * written by a MappedAllocator.
+	 */
+	void* Restore(size_t& bytes, size_t& usedBytes) override {
+		if (fd < 0 || mapping)
+			return nullptr;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || (size_t)info.st_size <= HeaderSize)
+			return nullptr;
+
+		size_t length = info.st_size;
+		char* region = MapFile(length);
+		Header* header = (Header*)region;
+		if (header->magic != Magic || header->usedBytes > length - HeaderSize) {
+			munmap(region, length);
+			return nullptr;
+		}
+		mapping = region;
+		bytes = length - HeaderSize;
+		usedBytes = header->usedBytes;
+		return mapping + HeaderSize;
+	}
+
+	/**
+	 * @brief Records the number of bytes in use in the file header
+	 */
+	void Persist(void* /*block*/, size_t usedBytes) override {
+		if (fd >= 0 && mapping)
+			((Header*)mapping)->usedBytes = usedBytes;
+	}
+
+private:
+	/**
+	 * @brief Layout of the first page of a backing file
+	 */
+	struct Header {
+		uint64_t magic;      ///< Identifies files written by this allocator
+		uint64_t usedBytes;  ///< Bytes of live data following the header
+	};
+
+	static const size_t HeaderSize = 4096;                ///< Header occupies one page
+	static const uint64_t Magic = 0x314d4150414d4556ULL;  ///< "VEMAPAM1"
+
+	static size_t PageRound(size_t bytes) {
+		static const size_t page = sysconf(_SC_PAGESIZE);
+		if (bytes == 0)
+			bytes = 1;
+		return (bytes + page - 1) & ~(page - 1);
+	}
+
+	char* MapAnonymous(size_t length) {
+		void* region = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (region == MAP_FAILED)
+			throw std::bad_alloc();
+		Advise(region, length);
+		return (char*)region;
+	}
+
+	char* MapFile(size_t length) {
+		void* region = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (region == MAP_FAILED)
+			throw std::bad_alloc();
+		Advise(region, length);
+		return (char*)region;
+	}
+
+	char* Remap(void* region, size_t oldLength, size_t newLength) {
+		void* moved = mremap(region, oldLength, newLength, MREMAP_MAYMOVE);
+		if (moved == MAP_FAILED)
+			throw std::bad_alloc();
+		Advise(moved, newLength);
+		return (char*)moved;
+	}
+
+	void Resize(size_t length) {
+		if (ftruncate(fd, length) != 0)
+			throw std::bad_alloc();
+	}
+
+	void Advise(void* region, size_t length) {
+#ifdef MADV_HUGEPAGE
+		if (hugePages)
+			madvise(region, length, MADV_HUGEPAGE);
+#endif
+	}
+
+	int fd;          ///< Backing file descriptor, -1 in anonymous mode
+	char* mapping;   ///< Start of the file mapping (header page), file mode only
+	bool hugePages;  ///< Whether to request transparent huge pages
+};
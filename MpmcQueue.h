@@ -0,0 +1,352 @@
+/**
+ * @file MpmcQueue.h
+ * @brief Bounded multi-producer/multi-consumer queue
+ *
+ * Array-based FIFO shared by any number of producer and consumer threads,
+ * following Dmitry Vyukov's bounded MPMC design: every slot carries a
+ * sequence number that tells a thread whether the slot is ready for the
+ * ticket it claimed.
+ *
+ * Features:
+ * - Non-blocking TryPush/TryPop
+ * - Blocking Push/Pop that spin briefly, then park on a condition variable
+ * - Bulk push/pop that claim several consecutive slots with one CAS
+ */
+
+// filepath: e:\Playground\MpmcQueue.h
+#pragma once
+#include "Allocator.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <thread>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @class MpmcQueue
+ * @brief Bounded lock-free FIFO for many producers and many consumers
+ *
+ * enqueuePos and dequeuePos hand out tickets. The slot for ticket t is
+ * free for a producer when its sequence equals t, and holds data for a
+ * consumer when its sequence equals t + 1. After consuming, the consumer
+ * sets the sequence to t + capacity, freeing the slot for the next lap.
+ */
+class MpmcQueue {
+public:
+	static const size_t CacheLineSize = 64;  ///< Assumed destructive interference size
+	static const int SpinLimit = 128;        ///< Failed attempts before a blocking call parks
+
+	/**
+	 * @brief Constructs an empty queue
+	 * @param capacity Minimum number of elements; rounded up to a power of two
+	 * @param allocator Allocator used for the slot array (heap if null)
+	 */
+	explicit MpmcQueue(int capacity, Allocator* allocator = nullptr)
+		: allocator(allocator ? allocator : Allocator::Default()),
+		  pushWaiters(0), popWaiters(0), pushGeneration(0), popGeneration(0)
+	{
+		size_t size = 2;
+		while (size < (size_t)capacity)
+			size <<= 1;
+		mask = size - 1;
+		slots = (Slot*)this->allocator->Allocate(sizeof(Slot) * size, CacheLineSize);
+		for (size_t i = 0; i < size; ++i)
+			new (&slots[i]) Slot{{i}, 0};
+		enqueuePos.store(0, std::memory_order_relaxed);
+		dequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	MpmcQueue(const MpmcQueue&) = delete;
+	MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+	~MpmcQueue() {
+		allocator->Deallocate(slots, sizeof(Slot) * (mask + 1), CacheLineSize);
+	}
+
+	/**
+	 * @brief Enqueues one element without blocking
+	 * @param value The element to enqueue
+	 * @return false if the queue is full
+	 */
+	bool TryPush(int value) {
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot& slot = slots[pos & mask];
+			intptr_t diff = (intptr_t)slot.sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		Publish(pos, value);
+		WakeConsumers();
+		return true;
+	}
+
+	/**
+	 * @brief Dequeues one element without blocking
+	 * @param value Receives the dequeued element
+	 * @return false if the queue is empty
+	 */
+	bool TryPop(int& value) {
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot& slot = slots[pos & mask];
+			intptr_t diff = (intptr_t)slot.sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+			if (diff == 0) {
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+		value = Consume(pos);
+		WakeProducers();
+		return true;
+	}
+
+	/**
+	 * @brief Enqueues up to count elements without blocking
+	 * @param data Elements to enqueue, oldest first
+	 * @param count Number of elements offered
+	 * @return Number of elements enqueued (a prefix of data)
+	 *
+	 * Claims a run of consecutive tickets with a single CAS. The run stops
+	 * at the first slot that a consumer has not drained yet, so every
+	 * claimed slot is already free and the call never waits on another
+	 * thread: no other producer can touch those slots once the CAS has
+	 * moved enqueuePos past them.
+	 */
+	int TryPushN(const int* data, int count) {
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		size_t n;
+		for (;;) {
+			intptr_t diff = (intptr_t)slots[pos & mask].sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+			if (diff < 0 || count <= 0)
+				return 0;
+			if (diff > 0) {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+				continue;
+			}
+			size_t limit = std::min((size_t)count, mask + 1);
+			n = 1;
+			while (n < limit && slots[(pos + n) & mask].sequence.load(std::memory_order_acquire) == pos + n)
+				++n;
+			if (enqueuePos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+				break;
+		}
+		for (size_t i = 0; i < n; ++i)
+			Publish(pos + i, data[i]);
+		WakeConsumers();
+		return n;
+	}
+
+	/**
+	 * @brief Dequeues up to count elements without blocking
+	 * @param out Destination for the elements, oldest first
+	 * @param count Maximum number of elements to dequeue
+	 * @return Number of elements dequeued
+	 *
+	 * Claims a run of consecutive tickets with a single CAS, mirroring
+	 * TryPushN: the run stops at the first slot that is not yet published,
+	 * so the call never waits on a producer.
+	 */
+	int TryPopN(int* out, int count) {
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		size_t n;
+		for (;;) {
+			intptr_t diff = (intptr_t)slots[pos & mask].sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+			if (diff < 0 || count <= 0)
+				return 0;
+			if (diff > 0) {
+				pos = dequeuePos.load(std::memory_order_relaxed);
+				continue;
+			}
+			size_t limit = std::min((size_t)count, mask + 1);
+			n = 1;
+			while (n < limit && slots[(pos + n) & mask].sequence.load(std::memory_order_acquire) == pos + n + 1)
+				++n;
+			if (dequeuePos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+				break;
+		}
+		for (size_t i = 0; i < n; ++i)
+			out[i] = Consume(pos + i);
+		WakeProducers();
+		return n;
+	}
+
+	/**
+	 * @brief Enqueues one element, blocking while the queue is full
+	 * @param value The element to enqueue
+	 */
+	void Push(int value) {
+		for (int spin = 0; spin < SpinLimit; ++spin)
+			if (TryPush(value))
+				return;
+		Park(pushWaiters, pushGeneration, notFull, [&] { return TryPush(value); });
+	}
+
+	/**
+	 * @brief Dequeues one element, blocking while the queue is empty
+	 * @return The dequeued element
+	 */
+	int Pop() {
+		int value;
+		for (int spin = 0; spin < SpinLimit; ++spin)
+			if (TryPop(value))
+				return value;
+		Park(popWaiters, popGeneration, notEmpty, [&] { return TryPop(value); });
+		return value;
+	}
+
+	/**
+	 * @brief Enqueues all count elements, blocking while the queue is full
+	 * @param data Elements to enqueue, oldest first
+	 * @param count Number of elements
+	 *
+	 * Elements from one call stay in order but may interleave with other
+	 * producers when the queue fills up part-way.
+	 */
+	void PushN(const int* data, int count) {
+		int done = 0;
+		while (done < count) {
+			int spin = 0;
+			int n;
+			while ((n = TryPushN(data + done, count - done)) == 0 && ++spin < SpinLimit) {}
+			if (n == 0)
+				Park(pushWaiters, pushGeneration, notFull, [&] { return (n = TryPushN(data + done, count - done)) > 0; });
+			done += n;
+		}
+	}
+
+	/**
+	 * @brief Dequeues between 1 and count elements, blocking while empty
+	 * @param out Destination for the elements, oldest first
+	 * @param count Maximum number of elements to dequeue
+	 * @return Number of elements dequeued (at least 1 when count > 0)
+	 */
+	int PopN(int* out, int count) {
+		if (count <= 0)
+			return 0;
+		int n;
+		for (int spin = 0; spin < SpinLimit; ++spin)
+			if ((n = TryPopN(out, count)) > 0)
+				return n;
+		Park(popWaiters, popGeneration, notEmpty, [&] { return (n = TryPopN(out, count)) > 0; });
+		return n;
+	}
+
+	/**
+	 * @brief Returns the number of queued elements
+	 * @return A snapshot; may be stale as soon as it is returned
+	 */
+	int Size() const {
+		intptr_t size = (intptr_t)(enqueuePos.load(std::memory_order_relaxed)
+			- dequeuePos.load(std::memory_order_relaxed));
+		return (int)std::max<intptr_t>(0, std::min<intptr_t>(size, mask + 1));
+	}
+
+	/**
+	 * @brief Returns the maximum number of elements the queue can hold
+	 */
+	int Capacity() const {
+		return mask + 1;
+	}
+
+private:
+	/**
+	 * @brief One cell of the ring
+	 */
+	struct Slot {
+		std::atomic<size_t> sequence;  ///< Ticket this slot is ready for
+		int value;                     ///< Stored element
+	};
+
+	void Publish(size_t pos, int value) {
+		Slot& slot = slots[pos & mask];
+		slot.value = value;
+		slot.sequence.store(pos + 1, std::memory_order_release);
+	}
+
+	int Consume(size_t pos) {
+		Slot& slot = slots[pos & mask];
+		int value = slot.value;
+		slot.sequence.store(pos + mask + 1, std::memory_order_release);
+		return value;
+	}
+
+	/**
+	 * @brief Blocks on a condition variable until attempt() succeeds
+	 *
+	 * The waiter count is raised before retrying, and wakers read it after
+	 * a full fence, so either the retry sees the other side's progress or
+	 * the waker bumps the generation. The retry runs without the mutex
+	 * (it may wake the opposite side), and the generation tells the waiter
+	 * whether a wake-up arrived while it was unlocked.
+	 */
+	template<typename Attempt>
+	void Park(std::atomic<int>& waiters, unsigned int& generation,
+		std::condition_variable& condition, Attempt attempt)
+	{
+		waiters.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::unique_lock<std::mutex> lock(parkMutex);
+		for (;;) {
+			unsigned int seen = generation;
+			lock.unlock();
+			bool done = attempt();
+			lock.lock();
+			if (done)
+				break;
+			while (generation == seen)
+				condition.wait(lock);
+		}
+		waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void WakeConsumers() {
+		Wake(popWaiters, popGeneration, notEmpty);
+	}
+
+	void WakeProducers() {
+		Wake(pushWaiters, pushGeneration, notFull);
+	}
+
+	void Wake(std::atomic<int>& waiters, unsigned int& generation, std::condition_variable& condition) {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiters.load(std::memory_order_relaxed) == 0)
+			return;
+		{
+			std::lock_guard<std::mutex> lock(parkMutex);
+			generation += 1;
+		}
+		condition.notify_all();
+	}
+
+	Slot* slots;           ///< Ring of capacity slots
+	size_t mask;           ///< Capacity - 1
+	Allocator* allocator;  ///< Source of the slot array
+
+	alignas(CacheLineSize) std::atomic<size_t> enqueuePos;  ///< Next producer ticket
+	alignas(CacheLineSize) std::atomic<size_t> dequeuePos;  ///< Next consumer ticket
+
+	alignas(CacheLineSize) std::atomic<int> pushWaiters;  ///< Producers parked on notFull
+	std::atomic<int> popWaiters;                          ///< Consumers parked on notEmpty
+	unsigned int pushGeneration;                          ///< Bumped on every producer wake-up
+	unsigned int popGeneration;                           ///< Bumped on every consumer wake-up
+	std::mutex parkMutex;                                 ///< Guards parking and the generations
+	std::condition_variable notFull;                      ///< Signalled after a pop
+	std::condition_variable notEmpty;                     ///< Signalled after a push
+};
@@ -5,12 +5,219 @@
  * Provides a static utility function for printing arrays with customizable
  * before/after formatting functions. Used as a base class or utility for
  * data structures that need formatted output.
+ *
+ * Large sequences go through OutputBuffer instead of iostreams: integers
+ * are formatted with std::to_chars into one reusable buffer that is handed
+ * to the kernel with a single write(2), and a binary mode writes the raw
+ * int array without formatting at all.
  */
 
 // filepath: e:\Playground\PrintableSequence.h
 #pragma once
 #include <iostream>
 #include <functional>
+#include <memory>
+#include <charconv>
+#include <system_error>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+/**
+ * @class OutputBuffer
+ * @brief Large write buffer over a file descriptor
+ *
+ * Text accumulates in the buffer and reaches the descriptor only on
+ * Flush() or when the buffer is full, so printing millions of integers
+ * costs a handful of system calls. Raw binary data too large to copy is
+ * sent together with the pending text in one writev(2).
+ *
+ * Not thread-safe; use one buffer per thread.
+ */
+class OutputBuffer {
+public:
+	static const size_t DefaultCapacity = 1 << 20;  ///< 1 MiB
+	static const size_t MaxIntChars = 11;           ///< "-2147483648"
+
+	/**
+	 * @brief Constructor
+	 * @param fd Descriptor the buffer is flushed to (not closed by the buffer)
+	 * @param capacity Buffer size in bytes
+	 */
+	explicit OutputBuffer(int fd = STDOUT_FILENO, size_t capacity = DefaultCapacity)
+		: fd(fd), capacity(capacity < 64 ? 64 : capacity), buffer(new char[this->capacity])
+	{
+	}
+
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+	/**
+	 * @brief Destructor - flushes whatever is still buffered
+	 */
+	~OutputBuffer() {
+		try {
+			Flush();
+		}
+		catch (const std::system_error&) {
+		}
+	}
+
+	/**
+	 * @brief Returns the process-wide buffer for standard output
+	 */
+	static OutputBuffer& Standard() {
+		static OutputBuffer out(STDOUT_FILENO);
+		return out;
+	}
+
+	/**
+	 * @brief Appends text
+	 */
+	void Write(const char* text, size_t length) {
+		if (length > capacity - used)
+			Flush();
+		if (length > capacity) {
+			WriteAll(text, length);
+			return;
+		}
+		memcpy(buffer.get() + used, text, length);
+		used += length;
+	}
+
+	void Write(const char* text) {
+		Write(text, strlen(text));
+	}
+
+	/**
+	 * @brief Appends the decimal form of value
+	 */
+	void WriteInt(int value) {
+		if (capacity - used < MaxIntChars)
+			Flush();
+		used = std::to_chars(buffer.get() + used, buffer.get() + capacity, value).ptr - buffer.get();
+	}
+
+	/**
+	 * @brief Opens a "[a, b, ...]" list; elements follow through WriteItems
+	 */
+	void BeginList() {
+		Write("[", 1);
+		listEmpty = true;
+	}
+
+	/**
+	 * @brief Appends elements to the open list
+	 * @param data Elements
+	 * @param n Number of elements
+	 *
+	 * May be called several times to print a sequence stored in pieces.
+	 */
+	void WriteItems(const int* data, int n) {
+		for (int i = 0; i < n; ++i) {
+			if (capacity - used < MaxIntChars + 2)
+				Flush();
+			char* out = buffer.get() + used;
+			if (!listEmpty) {
+				out[0] = ',';
+				out[1] = ' ';
+				out += 2;
+			}
+			listEmpty = false;
+			used = std::to_chars(out, buffer.get() + capacity, data[i]).ptr - buffer.get();
+		}
+	}
+
+	/**
+	 * @brief Closes the list opened by BeginList
+	 */
+	void EndList() {
+		Write("]", 1);
+	}
+
+	/**
+	 * @brief Appends raw bytes (binary dump)
+	 * @param data Bytes to write, e.g. an int array in host byte order
+	 * @param bytes Number of bytes
+	 *
+	 * Small blocks are copied into the buffer; a block that does not fit is
+	 * written straight from the caller's memory together with the pending
+	 * text in a single writev(2).
+	 */
+	void WriteRaw(const void* data, size_t bytes) {
+		if (bytes <= capacity - used) {
+			memcpy(buffer.get() + used, data, bytes);
+			used += bytes;
+			return;
+		}
+		SyncStandardStreams();
+		iovec parts[2] = {
+			{ buffer.get(), used },
+			{ const_cast<void*>(data), bytes }
+		};
+		WriteAll(parts, 2);
+		used = 0;
+	}
+
+	/**
+	 * @brief Hands the buffered bytes to the descriptor
+	 *
+	 * Anything already written to std::cout is flushed first so output from
+	 * both paths comes out in program order. Throws std::system_error if
+	 * the write fails.
+	 */
+	void Flush() {
+		if (used == 0)
+			return;
+		SyncStandardStreams();
+		WriteAll(buffer.get(), used);
+		used = 0;
+	}
+
+private:
+	void SyncStandardStreams() {
+		if (fd == STDOUT_FILENO) {
+			std::cout.flush();
+			fflush(stdout);
+		}
+	}
+
+	void WriteAll(const char* data, size_t bytes) {
+		iovec part = { const_cast<char*>(data), bytes };
+		WriteAll(&part, 1);
+	}
+
+	/**
+	 * @brief writev until every byte is out, resuming after partial writes
+	 */
+	void WriteAll(iovec* parts, int count) {
+		while (count > 0) {
+			ssize_t written = writev(fd, parts, count);
+			if (written < 0) {
+				if (errno == EINTR)
+					continue;
+				throw std::system_error(errno, std::generic_category(), "OutputBuffer write failed");
+			}
+			while (count > 0 && (size_t)written >= parts->iov_len) {
+				written -= parts->iov_len;
+				++parts;
+				--count;
+			}
+			if (count > 0) {
+				parts->iov_base = (char*)parts->iov_base + written;
+				parts->iov_len -= written;
+			}
+		}
+	}
+
+	int fd;                          ///< Destination descriptor
+	size_t capacity;                 ///< Buffer size in bytes
+	std::unique_ptr<char[]> buffer;  ///< Pending output
+	size_t used = 0;                 ///< Bytes pending in buffer
+	bool listEmpty = true;           ///< No element written since BeginList
+};
 
 /**
  * @class PrintableSequence
@@ -45,6 +252,38 @@ static void Print(int* arr, int size,
 	if (after)
 	after(arr, size);
 }
+
+/**
+ * @brief Prints an integer array through an OutputBuffer
+ * @param arr Pointer to the integer array to print
+ * @param size Number of elements in the array (may be 0)
+ * @param before Text written before the array
+ * @param after Text written after the array
+ * @param out Buffer to write to (standard output by default)
+ *
+ * Same [elem1, elem2, ..., elemN] format as the hook version, but without
+ * an iostream call per element; the buffer is flushed at the end.
+ */
+static void Print(const int* arr, int size, const char* before, const char* after,
+	OutputBuffer& out = OutputBuffer::Standard()) {
+	out.Write(before);
+	out.BeginList();
+	out.WriteItems(arr, size);
+	out.EndList();
+	out.Write(after);
+	out.Flush();
+}
+
+/**
+ * @brief Writes the raw bytes of an integer array, no formatting
+ * @param arr Pointer to the integer array
+ * @param size Number of elements
+ * @param out Buffer to write to (standard output by default)
+ */
+static void Dump(const int* arr, int size, OutputBuffer& out = OutputBuffer::Standard()) {
+	out.WriteRaw(arr, sizeof(int) * size);
+	out.Flush();
+}
 protected:
 	/**
 	 * @brief Protected constructor to prevent direct instantiation
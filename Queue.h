@@ -1,46 +1,66 @@
 /**
  * @file Queue.h
- * @brief Queue data structure implementation using dynamic array
+ * @brief Queue data structure implementation using a circular buffer
  *
- * Implements a First-In-First-Out (FIFO) data structure with automatic
- * memory management and cleanup optimizations.
+ * Implements a First-In-First-Out (FIFO) data structure on top of a
+ * power-of-two ring buffer, so both ends are updated in O(1) without
+ * ever shifting the stored elements.
  *
  * Features:
- * - Push/Pop operations
+ * - Push/Pop operations in O(1)
  * - Front and back element access
- * - Memory optimization with periodic cleanup
- * - Printable interface for debugging
+ * - Bulk PushN/PopN using at most two memcpy calls
+ * - Printable interface for debugging, buffered text and raw binary dumps
+ * - Pluggable allocator for the underlying storage
  */
 
 // filepath: e:\Playground\Queue.h
 #pragma once
 #include "Vector.h"
 #include "PrintableSequence.h"
+#include <algorithm>
 #include <assert.h>
 
 /**
  * @class Queue
  * @brief FIFO data structure implementation
  *
- * Uses an underlying Vector for storage with front/back pointers
- * for efficient queue operations and memory optimization.
+ * Uses an underlying Vector as a circular buffer whose size is always a
+ * power of two. head and tail are free-running counters; masking them with
+ * capacity - 1 gives the physical slot, and tail - head is the element count.
  */
 class Queue : public PrintableSequence {
 public:
 	/**
 	 * @brief Default constructor - creates an empty queue
 	 */
-	Queue() {}
+	Queue()
+		: v(InitialCapacity)
+	{
+	}
+
+	/**
+	 * @brief Constructor with a custom allocator
+	 * @param allocator Allocator used for the underlying storage (heap if null)
+	 *
+	 * Lets a whole batch of short-lived containers share one arena or pool.
+	 */
+	explicit Queue(Allocator* allocator)
+		: v(InitialCapacity, 0, allocator)
+	{
+	}
 
 	/**
 	 * @brief Constructor from initializer list
 	 * @param data Initializer list containing initial elements to enqueue
+	 * @param allocator Allocator used for the underlying storage (heap if null)
 	 *
 	 * Elements are enqueued in the order they appear in the list.
 	 */
-	Queue(std::initializer_list<int> data) {
-		for (auto& item : data)
-			Push(item);
+	Queue(std::initializer_list<int> data, Allocator* allocator = nullptr)
+		: v(InitialCapacity, 0, allocator)
+	{
+		PushN(data.begin(), data.size());
 	}
 
 	/**
@@ -52,9 +72,9 @@ public:
 	 * Time complexity: O(1)
 	 */
 	int Top() {
-		if (top == 0)
+		if (IsEmpty())
 			assert(false);
-		return v[top - 1];
+		return v.RawData()[(tail - 1) & mask];
 	}
 
 	/**
@@ -65,37 +85,29 @@ public:
 	 * Time complexity: O(1)
 	 */
 	int Back() {
-		if (back == -1)
+		if (IsEmpty())
 			assert(false);
-		return v[back];
+		return v.RawData()[head & mask];
 	}
 
 
 	/**
 	 * @brief Removes the front element from the queue
 	 *
-	 * Performs memory optimization by cleaning up unused vector space
-	 * when back pointer exceeds threshold (10 elements).
-	 * This prevents memory waste from dequeued elements.
-	 * Time complexity: O(1) amortized, O(n) when cleanup occurs
+	 * Only advances the head counter; popping an empty queue does nothing.
+	 * Time complexity: O(1)
 	 */
 	void Pop() {
-		back += 1;
-		if (back > 10) // insert some fancy metric
-		{
-			v.RemoveIf([](int index, int item) {
-				return index <= 10;
-			});
-			back = 0;
-			top -= 10;
-		}
+		if (!IsEmpty())
+			head += 1;
 	}
+
 	/**
 	 * @brief Checks if the queue is empty
 	 * @return true if queue contains no elements, false otherwise
 	 */
 	bool IsEmpty() {
-		return Size() == 0;
+		return head == tail;
 	}
 
 	/**
@@ -103,7 +115,7 @@ public:
 	 * @return The size of the queue
 	 */
 	int Size() {
-		return top - back + 1;
+		return tail - head;
 	}
 
 	/**
@@ -113,31 +125,125 @@ public:
 	 * Time complexity: O(1) amortized
 	 */
 	void Push(int data) {
-		v.PushBack(data);
-		top += 1;
+		if (Size() == Capacity())
+			Grow(Size() + 1);
+		v.RawData()[tail & mask] = data;
+		tail += 1;
 	}
 
 	/**
-	 * @brief Prints the current contents of the queue
+	 * @brief Adds several elements to the back of the queue
+	 * @param data Pointer to the elements to enqueue, oldest first
+	 * @param count Number of elements
 	 *
-	 * Uses PrintableSequence utility to display queue contents
-	 * in a formatted manner for debugging purposes.
+	 * Grows at most once, then copies with at most two memcpy calls
+	 * (one on each side of the wrap point).
+	 * Time complexity: O(count) amortized
 	 */
-	void Print() {
-		int* data = v.RawData() + back + 1;
-		auto before = [](int* arr, int size) {
-			std::cout << "Queue: \n\t";
-		};
+	void PushN(const int* data, int count) {
+		if (Size() + count > Capacity())
+			Grow(Size() + count);
+		int* buffer = v.RawData();
+		int start = tail & mask;
+		int first = std::min(count, Capacity() - start);
+		memcpy(buffer + start, data, sizeof(int) * first);
+		memcpy(buffer, data + first, sizeof(int) * (count - first));
+		tail += count;
+	}
 
-		auto after = [](int* arr, int size) {
-			std::cout << "\n";
-		};
+	/**
+	 * @brief Removes several elements from the front of the queue
+	 * @param out Destination for the removed elements, oldest first
+	 * @param count Maximum number of elements to remove
+	 * @return Number of elements actually removed
+	 *
+	 * Copies with at most two memcpy calls.
+	 * Time complexity: O(count)
+	 */
+	int PopN(int* out, int count) {
+		count = std::min(count, Size());
+		const int* buffer = v.RawData();
+		int start = head & mask;
+		int first = std::min(count, Capacity() - start);
+		memcpy(out, buffer + start, sizeof(int) * first);
+		memcpy(out + first, buffer, sizeof(int) * (count - first));
+		head += count;
+		return count;
+	}
 
-		PrintableSequence::Print(data, Size(), before, after);
+	/**
+	 * @brief Prints the current contents of the queue
+	 * @param out Buffer to write to (standard output by default)
+	 *
+	 * Formats the one or two contiguous runs of the ring straight into the
+	 * buffer, front first; the buffer reaches the descriptor in 1 MiB writes.
+	 */
+	void Print(OutputBuffer& out = OutputBuffer::Standard()) {
+		int start = head & mask;
+		int first = std::min(Size(), Capacity() - start);
+		out.Write("Queue: \n\t");
+		out.BeginList();
+		out.WriteItems(v.RawData() + start, first);
+		out.WriteItems(v.RawData(), Size() - first);
+		out.EndList();
+		out.Write("\n");
+		out.Flush();
+	}
+
+	/**
+	 * @brief Writes the elements as raw ints (host byte order), front first
+	 * @param out Buffer to write to (standard output by default)
+	 *
+	 * No formatting at all; the runs go to the descriptor without a copy
+	 * when they are larger than the buffer.
+	 */
+	void Dump(OutputBuffer& out = OutputBuffer::Standard()) {
+		int start = head & mask;
+		int first = std::min(Size(), Capacity() - start);
+		out.WriteRaw(v.RawData() + start, sizeof(int) * first);
+		out.WriteRaw(v.RawData(), sizeof(int) * (Size() - first));
+		out.Flush();
 	}
 
 private:
-	Vector v;        ///< Underlying storage container
-	int back = -1;   ///< Index of the front element (next to be dequeued)
-	int top = 0;     ///< Index after the last element (next insertion position)
-};
\ No newline at end of file
+	static const int InitialCapacity = 8;  ///< Starting ring size (power of two)
+
+	/**
+	 * @brief Returns the ring size (always equal to v.Size())
+	 * @return Number of slots in the ring
+	 */
+	int Capacity() {
+		return mask + 1;
+	}
+
+	/**
+	 * @brief Enlarges the ring to the next power of two holding minCapacity
+	 * @param minCapacity Number of elements that must fit
+	 *
+	 * The Vector keeps the old slots in place; the wrapped prefix [0, tail)
+	 * is then moved once to just past the old end, which unwraps the buffer
+	 * under the new mask.
+	 */
+	void Grow(int minCapacity) {
+		int oldCapacity = Capacity();
+		int newCapacity = oldCapacity;
+		while (newCapacity < minCapacity)
+			newCapacity *= 2;
+
+		int count = Size();
+		int start = head & mask;
+		v.Resize(newCapacity);
+		int wrapped = start + count - oldCapacity;
+		if (wrapped > 0)
+			memcpy(v.RawData() + oldCapacity, v.RawData(), sizeof(int) * wrapped);
+
+		mask = newCapacity - 1;
+		head = start;
+		tail = start + count;
+	}
+
+	Vector v;                                 ///< Ring storage; v.Size() is the capacity
+	unsigned int head = 0;                    ///< Counter of the front element (next to be dequeued)
+	unsigned int tail = 0;                    ///< Counter after the last element (next insertion)
+	unsigned int mask = InitialCapacity - 1;  ///< Capacity - 1, maps counters to slots
+};
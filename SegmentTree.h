@@ -1,13 +1,21 @@
 /**
  * @file SegmentTree.h
- * @brief Segment Tree data structure implementation for range sum queries
+ * @brief Segment Tree data structure implementation for range queries over a monoid
  *
  * Implements a Segment Tree that efficiently supports:
  * - Point updates: modify a single element
- * - Range queries: calculate sum over any range
+ * - Range queries: combine the elements of any range
  *
- * Uses array-based representation where tree[i] represents the sum
- * of a specific range, and leaf nodes contain the original values.
+ * Uses array-based representation where tree[i] represents the combined
+ * value of a specific range, and leaf nodes contain the original values.
+ *
+ * The operation is a monoid type (value type, identity, combine) whose
+ * functions are static, so the compiler inlines them into the tree loops.
+ * Sum, min, max, gcd and argmin monoids are provided; custom aggregates
+ * only need the same three members. combine need not be commutative.
+ *
+ * Batched applyUpdates recomputes each shared ancestor once per batch;
+ * batched queryMany prefetches the leaves of upcoming range queries.
  *
  * Time complexity: O(log n) for both updates and queries
  * Space complexity: O(n)
@@ -17,30 +25,105 @@
 #pragma once
 
 #include<vector>
+#include<utility>
+#include<algorithm>
+#include<numeric>
+#include<limits>
+#include<stddef.h>
+
+/**
+ * @brief Monoid of T under addition (the default)
+ */
+template<typename T>
+struct SumMonoid {
+	typedef T Value;
+	static Value identity() { return Value(); }
+	static Value combine(const Value& a, const Value& b) { return a + b; }
+};
+
+/**
+ * @brief Monoid of T under min
+ */
+template<typename T>
+struct MinMonoid {
+	typedef T Value;
+	static Value identity() { return std::numeric_limits<T>::max(); }
+	static Value combine(const Value& a, const Value& b) { return b < a ? b : a; }
+};
+
+/**
+ * @brief Monoid of T under max
+ */
+template<typename T>
+struct MaxMonoid {
+	typedef T Value;
+	static Value identity() { return std::numeric_limits<T>::lowest(); }
+	static Value combine(const Value& a, const Value& b) { return a < b ? b : a; }
+};
+
+/**
+ * @brief Monoid of integers under gcd (identity 0)
+ */
+template<typename T>
+struct GcdMonoid {
+	typedef T Value;
+	static Value identity() { return Value(); }
+	static Value combine(const Value& a, const Value& b) { return std::gcd(a, b); }
+};
+
+/**
+ * @brief Monoid of (value, index) pairs keeping the minimum value, leftmost on ties
+ *
+ * Build the leaves with ArgMinMonoid<T>::indexed(values).
+ */
+template<typename T>
+struct ArgMinMonoid {
+	typedef std::pair<T, int> Value;
+	static Value identity() { return Value(std::numeric_limits<T>::max(), std::numeric_limits<int>::max()); }
+	static Value combine(const Value& a, const Value& b) { return b < a ? b : a; }
+
+	static std::vector<Value> indexed(const std::vector<T>& values) {
+		std::vector<Value> leaves(values.size());
+		for (size_t i = 0; i < values.size(); ++i)
+			leaves[i] = Value(values[i], (int)i);
+		return leaves;
+	}
+};
 
 /**
  * @class SegmentTree
- * @brief Array-based segment tree for efficient range sum queries
+ * @brief Array-based segment tree for efficient range queries
+ * @tparam Monoid Operation: Value type, static identity() and combine(a, b)
  *
  * Uses a complete binary tree stored in an array where:
  * - Leaf nodes (indices n to 2n-1) store original values
- * - Internal nodes store sums of their children
+ * - Internal nodes store the combination of their children, left first
  * - Root is at index 1
  */
+template<typename Monoid = SumMonoid<int>>
 class SegmentTree{
 public:
+	typedef typename Monoid::Value Value;
+
+	/**
+	 * @brief Constructor for n elements that are all the identity
+	 */
+	explicit SegmentTree(int n)
+		: tree(2 * n, Monoid::identity()), n(n)
+	{
+	}
 
 	/**
 	 * @brief Constructor that builds the segment tree from input array
-	 * @param nums Vector of integers to build the tree from
+	 * @param nums Values to build the tree from
 	 *
 	 * Places original values at leaf positions (n to 2n-1) and builds
 	 * internal nodes by combining children values.
 	 * Time complexity: O(n)
 	 */
-	SegmentTree(std::vector<int> nums) {
+	SegmentTree(const std::vector<Value>& nums) {
 		n = nums.size();
-		tree.resize(2 * n, 0);
+		tree.resize(2 * n, Monoid::identity());
 
 		// Put the values at the leave nodes
 		for(int i = 0; i < n; ++i){
@@ -49,7 +132,7 @@ public:
 
 		// Build the rest of the tree
 		for (int i = n - 1; i > 0; --i){
-			tree[i] = tree[i * 2] + tree[i * 2 + 1];
+			tree[i] = Monoid::combine(tree[i * 2], tree[i * 2 + 1]);
 		}
 	}
 
@@ -62,50 +145,131 @@ public:
 	 * by recalculating all ancestor nodes.
 	 * Time complexity: O(log n)
 	 */
-	void update(int index, int newValue)  {
+	void update(int index, const Value& newValue)  {
 		index += n;
 		tree[index] = newValue;
 		for (index /= 2; index >= 1; index /= 2)
-			tree[index] = tree[2 * index] + tree[2 * index + 1];
-		// return;
-		while(index >= 1) {
-			index /= 2;
-			tree[index] = tree[index * 2] + tree[index * 2 + 1];
-		}
+			tree[index] = Monoid::combine(tree[2 * index], tree[2 * index + 1]);
 	}
 
 	/**
-	 * @brief Calculates sum of elements in given range
+	 * @brief Combines the elements in given range
 	 * @param left Left boundary of range (0-based, inclusive)
 	 * @param right Right boundary of range (0-based, inclusive)
-	 * @return Sum of elements in range [left, right]
+	 * @return element[left] combined with ... element[right], in that order
 	 *
-	 * Uses the segment tree structure to efficiently compute range sums
-	 * by combining appropriate internal nodes.
+	 * Nodes taken from the left boundary are appended to a left
+	 * accumulator and nodes from the right boundary are prepended to a
+	 * right accumulator, so the result keeps element order and is correct
+	 * for non-commutative operations.
 	 * Time complexity: O(log n)
 	 */
-	int sumRange(int left, int right) {
+	Value sumRange(int left, int right) const {
 		left += n;
 		right += n;
-		int answer = 0;
+		Value leftAnswer = Monoid::identity();
+		Value rightAnswer = Monoid::identity();
 		while(left <= right) {
 			if (left % 2 == 1) {
-				answer += tree[left];
+				leftAnswer = Monoid::combine(leftAnswer, tree[left]);
 				left += 1;
 			}
 			if (right % 2 == 0) {
-				answer += tree[right];
+				rightAnswer = Monoid::combine(tree[right], rightAnswer);
 				right -=1;
 			}
 			left /=2;
 			right /=2;
 		}
 
-		return answer;
+		return Monoid::combine(leftAnswer, rightAnswer);
+	}
+
+	/**
+	 * @brief Returns the number of elements
+	 */
+	int size() const {
+		return n;
+	}
+
+	/**
+	 * @brief Sets many elements at once
+	 * @param updates (0-based index, new value) pairs; for repeated indices the last one wins
+	 * @param count Number of updates
+	 *
+	 * Writes all leaves first, then recomputes their ancestors level by
+	 * level. For sparse batches the updated positions are sorted and each
+	 * level's node list is deduplicated, so an ancestor shared by several
+	 * updates is recomputed once; dense batches (count * log n >= n) simply
+	 * rebuild every internal node bottom-up.
+	 * Time complexity: O(min(n, k log k + distinct ancestors))
+	 */
+	void applyUpdates(const std::pair<int, Value>* updates, size_t count) {
+		for (size_t k = 0; k < count; ++k)
+			tree[updates[k].first + n] = updates[k].second;
+
+		size_t height = 0;
+		while (((size_t)1 << height) < (size_t)n)
+			++height;
+		if (count * (height + 1) >= (size_t)n) {
+			for (int i = n - 1; i > 0; --i)
+				tree[i] = Monoid::combine(tree[i * 2], tree[i * 2 + 1]);
+			return;
+		}
+
+		std::vector<int> nodes(count);
+		for (size_t k = 0; k < count; ++k)
+			nodes[k] = updates[k].first + n;
+		std::sort(nodes.begin(), nodes.end());
+		nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+		while (!nodes.empty() && nodes[0] > 1) {
+			size_t parents = 0;
+			for (int node : nodes) {
+				int parent = node / 2;
+				if (parents == 0 || nodes[parents - 1] != parent) {
+					nodes[parents++] = parent;
+					tree[parent] = Monoid::combine(tree[parent * 2], tree[parent * 2 + 1]);
+				}
+			}
+			nodes.resize(parents);
+		}
+	}
+
+	void applyUpdates(const std::vector<std::pair<int, Value>>& updates) {
+		applyUpdates(updates.data(), updates.size());
+	}
+
+	/**
+	 * @brief Answers many range queries
+	 * @param ranges (left, right) pairs, 0-based and inclusive
+	 * @param sums Receives sumRange(left, right) for every range
+	 * @param count Number of ranges
+	 *
+	 * The leaves and the lowest levels are where a query misses the cache,
+	 * so both boundary leaves of query j + PrefetchDistance are prefetched
+	 * while query j runs.
+	 */
+	void queryMany(const std::pair<int, int>* ranges, Value* sums, size_t count) const {
+		for (size_t k = 0; k < count; ++k) {
+			if (k + PrefetchDistance < count) {
+				__builtin_prefetch(&tree[ranges[k + PrefetchDistance].first + n]);
+				__builtin_prefetch(&tree[ranges[k + PrefetchDistance].second + n]);
+			}
+			sums[k] = sumRange(ranges[k].first, ranges[k].second);
+		}
+	}
+
+	std::vector<Value> queryMany(const std::vector<std::pair<int, int>>& ranges) const {
+		std::vector<Value> sums(ranges.size());
+		queryMany(ranges.data(), sums.data(), ranges.size());
+		return sums;
 	}
 
 
 private:
-	std::vector<int> tree;  ///< Array representation of the segment tree
-	int n;                  ///< Size of the original input array
+	static const int PrefetchDistance = 16;  ///< Batch entries prefetched ahead
+
+	std::vector<Value> tree;  ///< Array representation of the segment tree
+	int n;                    ///< Size of the original input array
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+/**
+ * @file SpscQueue.h
+ * @brief Lock-free single-producer/single-consumer queue
+ *
+ * Bounded ring buffer for passing integers from exactly one producer thread
+ * to exactly one consumer thread without locks.
+ *
+ * Features:
+ * - Acquire/release atomics only, no read-modify-write instructions
+ * - Producer and consumer indices on separate cache lines
+ * - Cached copy of the opposite index to avoid cross-core traffic
+ * - Batch PushN/PopN that publish many elements with one store
+ */
+
+// filepath: e:\Playground\SpscQueue.h
+#pragma once
+#include "Allocator.h"
+#include <atomic>
+#include <algorithm>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @class SpscQueue
+ * @brief Bounded wait-free FIFO for one producer and one consumer
+ *
+ * tail is written only by the producer and head only by the consumer; both
+ * are free-running counters masked by capacity - 1. Each side keeps a
+ * private copy of the other side's counter and re-reads the shared one only
+ * when the copy says the queue is full (producer) or empty (consumer), so in
+ * steady state each side touches the other's cache line once per lap rather
+ * than once per element.
+ */
+class SpscQueue {
+public:
+	static const size_t CacheLineSize = 64;  ///< Assumed destructive interference size
+
+	/**
+	 * @brief Constructs an empty queue
+	 * @param capacity Minimum number of elements; rounded up to a power of two
+	 * @param allocator Allocator used for the ring (heap if null)
+	 */
+	explicit SpscQueue(int capacity, Allocator* allocator = nullptr)
+		: allocator(allocator ? allocator : Allocator::Default())
+	{
+		size_t size = 2;
+		while (size < (size_t)capacity)
+			size <<= 1;
+		mask = size - 1;
+		buffer = (int*)this->allocator->Allocate(sizeof(int) * size, CacheLineSize);
+		head.store(0, std::memory_order_relaxed);
+		tail.store(0, std::memory_order_relaxed);
+		cachedHead = cachedTail = 0;
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	~SpscQueue() {
+		allocator->Deallocate(buffer, sizeof(int) * (mask + 1), CacheLineSize);
+	}
+
+	/**
+	 * @brief Enqueues one element (producer thread only)
+	 * @param value The element to enqueue
+	 * @return false if the queue is full
+	 */
+	bool TryPush(int value) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - cachedHead > mask) {
+			cachedHead = head.load(std::memory_order_acquire);
+			if (t - cachedHead > mask)
+				return false;
+		}
+		buffer[t & mask] = value;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Dequeues one element (consumer thread only)
+	 * @param value Receives the dequeued element
+	 * @return false if the queue is empty
+	 */
+	bool TryPop(int& value) {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h == cachedTail) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (h == cachedTail)
+				return false;
+		}
+		value = buffer[h & mask];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Enqueues up to count elements (producer thread only)
+	 * @param data Elements to enqueue, oldest first
+	 * @param count Number of elements offered
+	 * @return Number of elements actually enqueued
+	 *
+	 * Copies with at most two memcpy calls and publishes them all with a
+	 * single release store.
+	 */
+	int PushN(const int* data, int count) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		size_t capacity = mask + 1;
+		if (capacity - (t - cachedHead) < (size_t)count)
+			cachedHead = head.load(std::memory_order_acquire);
+		size_t n = std::min((size_t)count, capacity - (t - cachedHead));
+		if (n == 0)
+			return 0;
+
+		size_t start = t & mask;
+		size_t first = std::min(n, capacity - start);
+		memcpy(buffer + start, data, sizeof(int) * first);
+		memcpy(buffer, data + first, sizeof(int) * (n - first));
+		tail.store(t + n, std::memory_order_release);
+		return n;
+	}
+
+	/**
+	 * @brief Dequeues up to count elements (consumer thread only)
+	 * @param out Destination for the elements, oldest first
+	 * @param count Maximum number of elements to dequeue
+	 * @return Number of elements actually dequeued
+	 *
+	 * Copies with at most two memcpy calls and releases the slots with a
+	 * single store.
+	 */
+	int PopN(int* out, int count) {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (cachedTail - h < (size_t)count)
+			cachedTail = tail.load(std::memory_order_acquire);
+		size_t n = std::min((size_t)count, cachedTail - h);
+		if (n == 0)
+			return 0;
+
+		size_t capacity = mask + 1;
+		size_t start = h & mask;
+		size_t first = std::min(n, capacity - start);
+		memcpy(out, buffer + start, sizeof(int) * first);
+		memcpy(out + first, buffer, sizeof(int) * (n - first));
+		head.store(h + n, std::memory_order_release);
+		return n;
+	}
+
+	/**
+	 * @brief Returns the number of queued elements
+	 * @return A snapshot; exact only when neither side is running
+	 */
+	int Size() const {
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Returns the maximum number of elements the queue can hold
+	 */
+	int Capacity() const {
+		return mask + 1;
+	}
+
+private:
+	// Read-only after construction, shared by both sides.
+	alignas(CacheLineSize) int* buffer;  ///< Ring storage
+	size_t mask;                         ///< Capacity - 1
+	Allocator* allocator;                ///< Source of the ring storage
+
+	// Producer-owned line.
+	alignas(CacheLineSize) std::atomic<size_t> tail;  ///< Next slot to write
+	size_t cachedHead;                                ///< Producer's last view of head
+
+	// Consumer-owned line.
+	alignas(CacheLineSize) std::atomic<size_t> head;  ///< Next slot to read
+	size_t cachedTail;                                ///< Consumer's last view of tail
+};
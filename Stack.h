@@ -1,29 +1,35 @@
 /**
  * @file Stack.h
- * @brief Stack data structure implementation using dynamic array
+ * @brief Stack data structure implementation using linked chunks
  *
- * Implements a Last-In-First-Out (LIFO) data structure with automatic
- * memory management and cleanup optimizations.
+ * Implements a Last-In-First-Out (LIFO) data structure as a segmented
+ * stack: a list of fixed-size chunks linked from the top down. Existing
+ * elements are never copied when the stack grows or shrinks.
  *
  * Features:
- * - Push/Pop operations
+ * - Push/Pop operations in O(1)
  * - Top element access
- * - Memory optimization with periodic cleanup
- * - Printable interface for debugging
+ * - Bulk PushN/PopN operations
+ * - One cached empty chunk to avoid alloc/free churn at chunk boundaries
+ * - Printable interface for debugging, buffered text and raw binary dumps
+ * - Pluggable allocator for the underlying storage
  */
 
 // filepath: e:\Playground\Stack.h
 #pragma once
 #include "Vector.h"
 #include "PrintableSequence.h"
+#include <algorithm>
+#include <vector>
 #include <assert.h>
 
 /**
  * @class Stack
  * @brief LIFO data structure implementation
  *
- * Uses an underlying Vector for storage with additional tracking
- * for stack-specific operations and memory optimization.
+ * Elements live in page-sized chunks. Only the top chunk is partially
+ * filled; every chunk below it is full. Pop only moves the top index, and
+ * a chunk that becomes empty is kept as a spare for the next Push.
  */
 class Stack {
 public:
@@ -32,15 +38,73 @@ public:
 	 */
 	Stack() {}
 
+	/**
+	 * @brief Constructor with a custom allocator
+	 * @param allocator Allocator used for the underlying storage (heap if null)
+	 *
+	 * Lets a whole batch of short-lived containers share one arena or pool.
+	 */
+	explicit Stack(Allocator* allocator)
+		: allocator(allocator ? allocator : Allocator::Default())
+	{
+	}
+
 	/**
 	 * @brief Constructor from initializer list
 	 * @param data Initializer list containing initial elements to push onto stack
+	 * @param allocator Allocator used for the underlying storage (heap if null)
 	 *
 	 * Elements are pushed in the order they appear in the list.
 	 */
-	Stack(std::initializer_list<int> data) {
-		for (auto& item : data)
-			Push(item);
+	Stack(std::initializer_list<int> data, Allocator* allocator = nullptr)
+		: allocator(allocator ? allocator : Allocator::Default())
+	{
+		PushN(data.begin(), data.size());
+	}
+
+	/**
+	 * @brief Copy constructor - copies the elements using the same allocator
+	 * @param other Stack to copy from
+	 */
+	Stack(const Stack& other)
+		: allocator(other.allocator)
+	{
+		Vector items(other.count);
+		other.CopyTo(items.RawData());
+		PushN(items.RawData(), other.count);
+	}
+
+	/**
+	 * @brief Move constructor - takes over the other stack's chunks
+	 * @param other Stack to move from; left empty
+	 */
+	Stack(Stack&& other)
+		: allocator(other.allocator)
+	{
+		Swap(other);
+	}
+
+	/**
+	 * @brief Assignment - replaces the contents with a copy (or move) of other
+	 * @param other Stack to take the contents from
+	 * @return Reference to this stack
+	 */
+	Stack& operator=(Stack other) {
+		Swap(other);
+		return *this;
+	}
+
+	/**
+	 * @brief Destructor - returns every chunk to the allocator
+	 */
+	~Stack() {
+		while (current) {
+			Chunk* below = current->below;
+			allocator->Deallocate(current, sizeof(Chunk));
+			current = below;
+		}
+		if (spare)
+			allocator->Deallocate(spare, sizeof(Chunk));
 	}
 
 	/**
@@ -51,80 +115,211 @@ public:
 	 * Time complexity: O(1)
 	 */
 	int Top() {
-		if (top == 0)
+		if (count == 0)
 			assert(false);
-		return v[top - 1];
+		return current->items[used - 1];
 	}
 
 	/**
 	 * @brief Removes the top element from the stack
 	 *
-	 * Performs memory optimization by cleaning up unused vector space
-	 * when the difference between peak usage and current size is large.
-	 * This prevents memory waste in scenarios with large temporary growth.
-	 * Time complexity: O(1) amortized
+	 * Only moves the top index. When the top chunk becomes empty it is
+	 * unlinked and kept as the spare chunk (freeing the previous spare), so
+	 * pushing and popping across a chunk boundary never hits the allocator.
+	 * Time complexity: O(1)
 	 */
 	void Pop() {
-		if (top != 0)
-			top -= 1;
-		if (peak - top >= 10)
-		{
-			v.RemoveIf([&](int index, int item) {
-				return index > top;
-			});
-			peak -= 10;
-		}
+		if (count == 0)
+			return;
+		used -= 1;
+		count -= 1;
+		if (used == 0)
+			DropChunk();
 	}
+
 	/**
 	 * @brief Checks if the stack is empty
 	 * @return true if stack contains no elements, false otherwise
 	 */
 	bool IsEmpty() {
-		return top == 0;
+		return count == 0;
 	}
 
 	/**
 	 * @brief Adds an element to the top of the stack
 	 * @param data The element to push onto the stack
 	 *
-	 * Updates both the current top and peak counters for memory management.
-	 * Time complexity: O(1) amortized
+	 * Links a new chunk (the spare one if available) when the top chunk is full.
+	 * Time complexity: O(1)
 	 */
 	void Push(int data) {
-		v.PushBack(data);
-		top += 1;
-		peak += 1;
+		if (!current || used == ChunkSize)
+			AddChunk();
+		current->items[used] = data;
+		used += 1;
+		count += 1;
 	}
+
+	/**
+	 * @brief Pushes several elements onto the stack
+	 * @param data Elements to push, bottom-most first
+	 * @param n Number of elements
+	 *
+	 * Fills the top chunk and links new chunks with one memcpy each.
+	 * Time complexity: O(n)
+	 */
+	void PushN(const int* data, int n) {
+		while (n > 0) {
+			if (!current || used == ChunkSize)
+				AddChunk();
+			int k = std::min(n, ChunkSize - used);
+			memcpy(current->items + used, data, sizeof(int) * k);
+			used += k;
+			count += k;
+			data += k;
+			n -= k;
+		}
+	}
+
+	/**
+	 * @brief Pops several elements off the stack
+	 * @param out Destination, receives the elements in pop order (top first)
+	 * @param n Maximum number of elements to pop
+	 * @return Number of elements actually popped
+	 *
+	 * Time complexity: O(n)
+	 */
+	int PopN(int* out, int n) {
+		n = std::min(n, count);
+		int popped = 0;
+		while (popped < n) {
+			int k = std::min(n - popped, used);
+			std::reverse_copy(current->items + used - k, current->items + used, out + popped);
+			used -= k;
+			count -= k;
+			popped += k;
+			if (used == 0)
+				DropChunk();
+		}
+		return popped;
+	}
+
 	/**
 	 * @brief Returns the current number of elements in the stack
 	 * @return The size of the stack
 	 */
 	int Size() {
-		return top;
+		return count;
 	}
 
 	/**
-	 * @brief Prints the current contents of the stack
+	 * @brief Prints the current contents of the stack, bottom first
+	 * @param out Buffer to write to (standard output by default)
 	 *
-	 * Uses PrintableSequence utility to display stack contents
-	 * in a formatted manner for debugging purposes.
+	 * Formats each chunk straight into the buffer, which reaches the
+	 * descriptor in 1 MiB writes; nothing is gathered into a temporary array.
 	 */
-	void Print() {
-		int* data = v.RawData();
-		auto before = [](int* arr, int size) {
-			std::cout << "Stack: \n\t";
-		};
+	void Print(OutputBuffer& out = OutputBuffer::Standard()) {
+		out.Write("Stack: \n\t");
+		out.BeginList();
+		ForEachChunk([&out](const int* items, int n) {
+			out.WriteItems(items, n);
+		});
+		out.EndList();
+		out.Write("\n");
+		out.Flush();
+	}
 
-		auto after = [](int* arr, int size) {
-			std::cout << "\n";
-		};
+	/**
+	 * @brief Writes the elements as raw ints (host byte order), bottom first
+	 * @param out Buffer to write to (standard output by default)
+	 */
+	void Dump(OutputBuffer& out = OutputBuffer::Standard()) {
+		ForEachChunk([&out](const int* items, int n) {
+			out.WriteRaw(items, sizeof(int) * n);
+		});
+		out.Flush();
+	}
 
-		PrintableSequence::Print(data, Size(), before, after);
+private:
+	/**
+	 * @brief Number of elements per chunk, chosen so a chunk fills one 4 KiB page
+	 */
+	static const int ChunkSize = (4096 - sizeof(void*)) / sizeof(int);
+
+	/**
+	 * @brief Fixed-size block of elements linked to the chunk below it
+	 */
+	struct Chunk {
+		Chunk* below;          ///< Next chunk towards the bottom of the stack
+		int items[ChunkSize];  ///< Elements, bottom-most first
+	};
+
+	/**
+	 * @brief Links a fresh chunk on top, reusing the spare when there is one
+	 */
+	void AddChunk() {
+		Chunk* chunk = spare;
+		spare = nullptr;
+		if (!chunk)
+			chunk = (Chunk*)allocator->Allocate(sizeof(Chunk), alignof(Chunk));
+		chunk->below = current;
+		current = chunk;
+		used = 0;
 	}
 
+	/**
+	 * @brief Unlinks the empty top chunk and keeps it as the spare
+	 */
+	void DropChunk() {
+		Chunk* empty = current;
+		current = empty->below;
+		used = current ? ChunkSize : 0;
+		if (spare)
+			allocator->Deallocate(spare, sizeof(Chunk));
+		spare = empty;
+	}
 
-private:
-	Vector v;      ///< Underlying storage container
-	int top = 0;   ///< Current number of elements (top of stack index + 1)
-	int peak = 0;  ///< Maximum number of elements reached (for memory optimization)
-};
\ No newline at end of file
+	/**
+	 * @brief Copies all elements, bottom first, into a contiguous array
+	 * @param out Destination with room for Size() elements
+	 */
+	void CopyTo(int* out) const {
+		int position = count;
+		int n = used;
+		for (Chunk* chunk = current; chunk; chunk = chunk->below) {
+			position -= n;
+			memcpy(out + position, chunk->items, sizeof(int) * n);
+			n = ChunkSize;
+		}
+	}
+
+	/**
+	 * @brief Calls visit(items, n) for every chunk, bottom chunk first
+	 */
+	template<typename Visit>
+	void ForEachChunk(Visit visit) const {
+		std::vector<const Chunk*> chunks;
+		chunks.reserve(count / ChunkSize + 1);
+		for (const Chunk* chunk = current; chunk; chunk = chunk->below)
+			chunks.push_back(chunk);
+		for (size_t i = chunks.size(); i-- > 1;)
+			visit(chunks[i]->items, ChunkSize);
+		if (!chunks.empty())
+			visit(chunks[0]->items, used);
+	}
+
+	void Swap(Stack& other) {
+		std::swap(allocator, other.allocator);
+		std::swap(current, other.current);
+		std::swap(spare, other.spare);
+		std::swap(used, other.used);
+		std::swap(count, other.count);
+	}
+
+	Allocator* allocator = Allocator::Default();  ///< Source of the chunks
+	Chunk* current = nullptr;                     ///< Top chunk (null when empty)
+	Chunk* spare = nullptr;                       ///< Cached empty chunk
+	int used = 0;                                 ///< Elements in the top chunk
+	int count = 0;                                ///< Total number of elements
+};
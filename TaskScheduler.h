@@ -0,0 +1,337 @@
+/**
+ * @file TaskScheduler.h
+ * @brief Fork-join thread pool built on work-stealing deques
+ *
+ * Runs recursive divide-and-conquer code in parallel: a task spawns its
+ * subproblems into a TaskGroup and syncs on the group before combining the
+ * results. Idle threads steal the oldest spawned tasks from busy ones.
+ *
+ * Features:
+ * - One WorkStealingDeque per worker; spawned tasks go to the spawner's own deque
+ * - Sync() runs other tasks while waiting instead of blocking the thread
+ * - Threads outside the pool may spawn and sync too (they also help)
+ * - Idle workers spin briefly, then sleep until new work is spawned
+ */
+
+// filepath: e:\Playground\TaskScheduler.h
+#pragma once
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <stdint.h>
+#include <assert.h>
+
+class TaskGroup;
+
+/**
+ * @class TaskScheduler
+ * @brief Pool of worker threads executing TaskGroup tasks
+ *
+ * Each worker pops its own deque from the bottom, so a recursion runs
+ * depth-first on one thread exactly like the sequential version; thieves
+ * take from the top, where the biggest unstarted subproblems are. Tasks
+ * spawned from threads outside the pool go to a shared, mutex-protected
+ * injection list.
+ */
+class TaskScheduler {
+public:
+	static const int SpinLimit = 64;  ///< Failed searches before an idle worker sleeps
+
+	/**
+	 * @brief Starts the worker threads
+	 * @param threads Number of workers (hardware concurrency if 0)
+	 */
+	explicit TaskScheduler(int threads = 0) {
+		if (threads <= 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		workers.reserve(threads);
+		for (int i = 0; i < threads; ++i)
+			workers.push_back(new Worker());
+		for (int i = 0; i < threads; ++i)
+			workers[i]->thread = std::thread(&TaskScheduler::WorkerLoop, this, i);
+	}
+
+	TaskScheduler(const TaskScheduler&) = delete;
+	TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+	/**
+	 * @brief Destructor - stops and joins the workers
+	 *
+	 * Every TaskGroup must have been synced.
+	 */
+	~TaskScheduler() {
+		{
+			std::lock_guard<std::mutex> lock(parkMutex);
+			stopping.store(true, std::memory_order_relaxed);
+			generation.fetch_add(1, std::memory_order_relaxed);
+		}
+		parked.notify_all();
+		// Join everyone first: a running worker may still be stealing from any deque
+		for (Worker* worker : workers)
+			worker->thread.join();
+		for (Worker* worker : workers)
+			delete worker;
+	}
+
+	/**
+	 * @brief Returns the number of worker threads
+	 */
+	int ThreadCount() const {
+		return (int)workers.size();
+	}
+
+private:
+	friend class TaskGroup;
+
+	/**
+	 * @brief Type-erased unit of work, owned by the scheduler once spawned
+	 */
+	struct Task {
+		explicit Task(TaskGroup* group) : group(group) {}
+		virtual ~Task() {}
+		virtual void Execute() = 0;
+
+		TaskGroup* group;  ///< Group notified when the task finishes
+	};
+
+	template<typename Function>
+	struct FunctionTask : Task {
+		FunctionTask(TaskGroup* group, Function&& function)
+			: Task(group), function(std::move(function))
+		{
+		}
+
+		void Execute() override {
+			function();
+		}
+
+		Function function;  ///< The spawned callable
+	};
+
+	/**
+	 * @brief Per-thread state; padded so deques of different workers never share a line
+	 */
+	struct alignas(64) Worker {
+		WorkStealingDeque<Task*> deque;  ///< Tasks spawned by this worker
+		std::thread thread;              ///< The worker thread
+	};
+
+	/**
+	 * @brief Identifies the calling thread's worker slot in this scheduler
+	 * @return Worker index, or -1 for threads outside the pool
+	 */
+	int CurrentWorker() const {
+		return currentScheduler == this ? currentIndex : -1;
+	}
+
+	/**
+	 * @brief Queues a task on the caller's deque (or the injection list)
+	 */
+	void Submit(Task* task) {
+		int self = CurrentWorker();
+		if (self >= 0) {
+			workers[self]->deque.Push(task);
+		}
+		else {
+			std::lock_guard<std::mutex> lock(injectMutex);
+			injected.push_back(task);
+			injectedCount.store(injected.size(), std::memory_order_relaxed);
+		}
+		Wake();
+	}
+
+	/**
+	 * @brief Finds a runnable task: own deque first, then injected tasks, then steals
+	 * @return The task, or null if none was found
+	 */
+	Task* FindTask(int self) {
+		Task* task = nullptr;
+		if (self >= 0 && workers[self]->deque.TryPop(task))
+			return task;
+
+		if (injectedCount.load(std::memory_order_seq_cst) > 0) {
+			std::lock_guard<std::mutex> lock(injectMutex);
+			if (!injected.empty()) {
+				task = injected.back();
+				injected.pop_back();
+				injectedCount.store(injected.size(), std::memory_order_relaxed);
+				return task;
+			}
+		}
+
+		int n = (int)workers.size();
+		int start = (int)(NextRandom() % n);
+		for (int i = 0; i < n; ++i) {
+			int victim = (start + i) % n;
+			if (victim != self && workers[victim]->deque.TrySteal(task))
+				return task;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Runs a task and reports its completion to its group
+	 */
+	static void Execute(Task* task);
+
+	/**
+	 * @brief Main loop of worker thread index
+	 */
+	void WorkerLoop(int index) {
+		currentScheduler = this;
+		currentIndex = index;
+		int idle = 0;
+		while (!stopping.load(std::memory_order_relaxed)) {
+			uint64_t seen = generation.load(std::memory_order_acquire);
+			Task* task = FindTask(index);
+			if (task) {
+				Execute(task);
+				idle = 0;
+			}
+			else if (++idle < SpinLimit) {
+				std::this_thread::yield();
+			}
+			else {
+				Park(index, seen);
+				idle = 0;
+			}
+		}
+		currentScheduler = nullptr;
+	}
+
+	/**
+	 * @brief Sleeps until Wake() bumps the generation past seen
+	 *
+	 * The sleeper count is raised before the final search, and Submit()
+	 * checks it after publishing its task, so one of the two always sees
+	 * the other: either the search finds the task or the spawner wakes us.
+	 */
+	void Park(int index, uint64_t seen) {
+		sleepers.fetch_add(1, std::memory_order_seq_cst);
+		Task* task = FindTask(index);
+		if (task) {
+			sleepers.fetch_sub(1, std::memory_order_relaxed);
+			Execute(task);
+			return;
+		}
+		std::unique_lock<std::mutex> lock(parkMutex);
+		while (generation.load(std::memory_order_relaxed) == seen && !stopping.load(std::memory_order_relaxed))
+			parked.wait(lock);
+		sleepers.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Wakes one sleeping worker, if any
+	 */
+	void Wake() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleepers.load(std::memory_order_relaxed) == 0)
+			return;
+		{
+			std::lock_guard<std::mutex> lock(parkMutex);
+			generation.fetch_add(1, std::memory_order_release);
+		}
+		parked.notify_one();
+	}
+
+	static uint32_t NextRandom() {
+		static thread_local uint32_t state = (uint32_t)(uintptr_t)&state | 1;
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	static thread_local TaskScheduler* currentScheduler;  ///< Scheduler owning the calling thread
+	static thread_local int currentIndex;                 ///< Worker index of the calling thread
+
+	std::vector<Worker*> workers;           ///< Worker threads and their deques
+	std::mutex injectMutex;                 ///< Guards injected
+	std::vector<Task*> injected;            ///< Tasks spawned from outside the pool
+	std::atomic<size_t> injectedCount{0};   ///< Size of injected, readable without the lock
+	std::mutex parkMutex;                   ///< Serializes generation bumps with sleeping
+	std::condition_variable parked;         ///< Sleeping workers wait here
+	std::atomic<uint64_t> generation{0};    ///< Bumped by every wake-up
+	std::atomic<int> sleepers{0};           ///< Workers that may be sleeping
+	std::atomic<bool> stopping{false};      ///< Set by the destructor
+};
+
+inline thread_local TaskScheduler* TaskScheduler::currentScheduler = nullptr;
+inline thread_local int TaskScheduler::currentIndex = -1;
+
+/**
+ * @class TaskGroup
+ * @brief Set of spawned tasks that can be waited for together (spawn/sync)
+ *
+ * Typical use inside a recursive function:
+ *
+ *     TaskGroup group(scheduler);
+ *     group.Spawn([=] { solve(left); });
+ *     solve(right);
+ *     group.Sync();
+ *
+ * Sync() keeps the calling thread busy with other tasks until every task
+ * of the group has finished, so nested groups never deadlock the pool.
+ */
+class TaskGroup {
+public:
+	explicit TaskGroup(TaskScheduler& scheduler)
+		: scheduler(scheduler), pending(0)
+	{
+	}
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	/**
+	 * @brief Destructor - waits for any tasks still running
+	 */
+	~TaskGroup() {
+		Sync();
+	}
+
+	/**
+	 * @brief Spawns a task that may run on any thread of the pool
+	 * @param function Callable taking no arguments; captured by value
+	 */
+	template<typename Function>
+	void Spawn(Function function) {
+		pending.fetch_add(1, std::memory_order_relaxed);
+		scheduler.Submit(new TaskScheduler::FunctionTask<Function>(this, std::move(function)));
+	}
+
+	/**
+	 * @brief Waits until every task spawned into this group has finished
+	 *
+	 * Runs pending tasks (its own first) while waiting. Everything the tasks
+	 * wrote is visible to the caller afterwards.
+	 */
+	void Sync() {
+		int self = scheduler.CurrentWorker();
+		while (pending.load(std::memory_order_acquire) > 0) {
+			TaskScheduler::Task* task = scheduler.FindTask(self);
+			if (task)
+				TaskScheduler::Execute(task);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+private:
+	friend class TaskScheduler;
+
+	TaskScheduler& scheduler;  ///< Pool the tasks run on
+	std::atomic<int> pending;  ///< Spawned tasks that have not finished
+};
+
+inline void TaskScheduler::Execute(Task* task) {
+	TaskGroup* group = task->group;
+	task->Execute();
+	delete task;
+	group->pending.fetch_sub(1, std::memory_order_release);
+}
@@ -10,6 +10,9 @@
  * - Push/pop operations at front and back
  * - Random access with bounds checking
  * - Conditional element removal
+ * - Pluggable allocator for the underlying storage
+ * - Random-access iterators and bulk range operations
+ * - size_t sizes, so a MappedAllocator-backed vector can hold billions of ints
  */
 
 // filepath: e:\Playground\Vector.h
@@ -18,6 +21,12 @@
 #include <string.h>
 #include <functional>
 #include <assert.h>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include <stdint.h>
+#include "Allocator.h"
 
 /**
  * @class Vector
@@ -28,6 +37,9 @@
  */
 class Vector {
 public:
+	typedef int* Iterator;             ///< Random-access iterator over the elements
+	typedef const int* ConstIterator;  ///< Read-only random-access iterator
+
 	/**
 	 * @brief Default constructor - creates an empty vector with initial capacity
 	 *
@@ -35,28 +47,142 @@ public:
 	 * for small vectors.
 	 */
 	Vector()
-		: arr(nullptr), size(0), capacity(0)
+		: size(0), capacity(0), arr(nullptr), allocator(Allocator::Default())
 	{
 		Reallocate(6);
 	}
 
+	/**
+	 * @brief Constructor with a custom allocator
+	 * @param allocator Allocator used for the internal array (heap if null)
+	 *
+	 * The allocator must outlive the vector. With an ArenaAllocator the
+	 * storage is reclaimed by the arena, not by the vector's destructor.
+	 * If the allocator holds persisted storage (e.g. a file-backed
+	 * MappedAllocator) the vector reopens it with its previous contents.
+	 */
+	explicit Vector(Allocator* allocator)
+		: size(0), capacity(0), arr(nullptr),
+		  allocator(allocator ? allocator : Allocator::Default())
+	{
+		size_t bytes = 0, usedBytes = 0;
+		arr = (int*)this->allocator->Restore(bytes, usedBytes);
+		if (arr) {
+			capacity = bytes / sizeof(int);
+			size = usedBytes / sizeof(int);
+		}
+		else {
+			Reallocate(6);
+		}
+	}
+
 	/**
 	 * @brief Constructor from initializer list
 	 * @param data Initializer list containing initial elements
+	 * @param allocator Allocator used for the internal array (heap if null)
 	 *
 	 * Creates vector with elements from the initializer list.
 	 * Capacity is set to 1.5x the initial size for future growth.
 	 */
-	Vector(std::initializer_list<int> data)
-		: arr(nullptr), size(0), capacity(0)
+	Vector(std::initializer_list<int> data, Allocator* allocator = nullptr)
+		: size(0), capacity(0), arr(nullptr),
+		  allocator(allocator ? allocator : Allocator::Default())
 	{
-		Reallocate(data.size() * 1.5);
+		Reallocate(data.size() + data.size() / 2);
 		unsigned int i = 0;
 		for (auto& item : data)
 			arr[i++] = item;
 		size = data.size();
 	}
 
+	/**
+	 * @brief Constructor creating count copies of a value
+	 * @param count Number of elements
+	 * @param value Value of every element
+	 * @param allocator Allocator used for the internal array (heap if null)
+	 *
+	 * Performs a single allocation of exactly count elements.
+	 */
+	explicit Vector(size_t count, int value = 0, Allocator* allocator = nullptr)
+		: size(0), capacity(0), arr(nullptr),
+		  allocator(allocator ? allocator : Allocator::Default())
+	{
+		Reallocate(count);
+		Resize(count, value);
+	}
+
+	/**
+	 * @brief Constructor from an iterator range
+	 * @param first Iterator to the first element to copy
+	 * @param last Iterator past the last element to copy
+	 * @param allocator Allocator used for the internal array (heap if null)
+	 *
+	 * For forward iterators the range is measured first, so building the
+	 * vector costs one allocation regardless of its length.
+	 */
+	template<typename InputIt,
+		typename = typename std::iterator_traits<InputIt>::iterator_category>
+	Vector(InputIt first, InputIt last, Allocator* allocator = nullptr)
+		: size(0), capacity(0), arr(nullptr),
+		  allocator(allocator ? allocator : Allocator::Default())
+	{
+		Append(first, last);
+		if (!arr)
+			Reallocate(0);
+	}
+
+	/**
+	 * @brief Copy constructor - copies the elements using the same allocator
+	 * @param other Vector to copy from
+	 */
+	Vector(const Vector& other)
+		: size(0), capacity(0), arr(nullptr), allocator(other.allocator)
+	{
+		Reallocate(other.capacity);
+		memcpy(arr, other.arr, sizeof(int) * other.size);
+		size = other.size;
+	}
+
+	/**
+	 * @brief Move constructor - takes ownership of the other vector's array
+	 * @param other Vector to move from; left empty without storage
+	 */
+	Vector(Vector&& other)
+		: size(other.size), capacity(other.capacity), arr(other.arr), allocator(other.allocator)
+	{
+		other.arr = nullptr;
+		other.size = other.capacity = 0;
+	}
+
+	/**
+	 * @brief Copy assignment - replaces the contents with a copy of other
+	 * @param other Vector to copy from
+	 * @return Reference to this vector
+	 */
+	Vector& operator=(const Vector& other) {
+		if (this != &other) {
+			size = 0;
+			if (capacity < other.size)
+				Reallocate(other.capacity);
+			memcpy(arr, other.arr, sizeof(int) * other.size);
+			size = other.size;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Destructor - returns the internal array to the allocator
+	 *
+	 * Persistent allocators are told the final size first so the contents
+	 * can be reopened later.
+	 */
+	~Vector() {
+		if (arr) {
+			allocator->Persist(arr, sizeof(int) * size);
+			allocator->Deallocate(arr, sizeof(int) * capacity);
+		}
+	}
+
 	/**
 	 * @brief Adds an element to the end of the vector
 	 * @param data The element to add
@@ -66,7 +192,7 @@ public:
 	 */
 	void PushBack(int data) {
 		if (size == capacity)
-			Reallocate(capacity * 1.5);
+			Grow(size + 1);
 
 		arr[size] = data;
 		size += 1;
@@ -80,20 +206,130 @@ public:
 	 * Time complexity: O(n) due to element shifting
 	 */
 	void PushFront(int data) {
-		if (size + 1 >= capacity)
-			Reallocate(capacity * 1.5);
+		Grow(size + 1);
 
-		for (int i = size; i > 0; --i)
+		for (size_t i = size; i > 0; --i)
 			Swap(arr[i], arr[i - 1]);
 
 		arr[0] = data;
 		size += 1;
 	}
+	/**
+	 * @brief Appends a range of elements to the end of the vector
+	 * @param first Iterator to the first element to append
+	 * @param last Iterator past the last element to append
+	 *
+	 * Forward ranges reserve space once and are copied in bulk; single-pass
+	 * input ranges fall back to repeated PushBack. The range must not point
+	 * into this vector, since growing may move the storage.
+	 * Time complexity: amortized O(k) for k appended elements
+	 */
+	template<typename InputIt>
+	void Append(InputIt first, InputIt last) {
+		typedef typename std::iterator_traits<InputIt>::iterator_category Category;
+		if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+			size_t count = std::distance(first, last);
+			Grow(size + count);
+			std::copy(first, last, arr + size);
+			size += count;
+		}
+		else {
+			for (; first != last; ++first)
+				PushBack(*first);
+		}
+	}
+
+	/**
+	 * @brief Inserts a range of elements before the given index
+	 * @param index Position to insert at (0 <= index <= Size())
+	 * @param first Iterator to the first element to insert
+	 * @param last Iterator past the last element to insert
+	 *
+	 * Reserves once, shifts the tail with a single memmove and copies the
+	 * range in. The range must not point into this vector.
+	 * Time complexity: O(n + k)
+	 */
+	template<typename ForwardIt>
+	void Insert(size_t index, ForwardIt first, ForwardIt last) {
+		if (index > size)
+			assert(false);
+		size_t count = std::distance(first, last);
+		Grow(size + count);
+		memmove(arr + index + count, arr + index, sizeof(int) * (size - index));
+		std::copy(first, last, arr + index);
+		size += count;
+	}
+
+	/**
+	 * @brief Ensures capacity for at least the given number of elements
+	 * @param newCapacity Minimum capacity required
+	 *
+	 * Does nothing if the capacity is already large enough. Never shrinks.
+	 * Throws std::length_error if the byte size would not fit in size_t.
+	 */
+	void Reserve(size_t newCapacity) {
+		if (newCapacity <= capacity)
+			return;
+		if (newCapacity > MaxSize)
+			throw std::length_error("Vector size exceeds the addressable range");
+		Reallocate(newCapacity);
+	}
+
+	/**
+	 * @brief Changes the number of elements
+	 * @param newSize The new size
+	 * @param value Value given to elements added at the end
+	 *
+	 * Growing reserves exactly newSize elements if needed; shrinking keeps
+	 * the capacity.
+	 */
+	void Resize(size_t newSize, int value = 0) {
+		Reserve(newSize);
+		if (newSize > size)
+			std::fill(arr + size, arr + newSize, value);
+		size = newSize;
+	}
+
+	/**
+	 * @brief Removes all elements, keeping the capacity
+	 */
+	void Clear() {
+		size = 0;
+	}
+
+	/**
+	 * @brief Returns an iterator to the first element
+	 */
+	Iterator begin() {
+		return arr;
+	}
+
+	/**
+	 * @brief Returns an iterator past the last element
+	 */
+	Iterator end() {
+		return arr + size;
+	}
+
+	/**
+	 * @brief Returns a read-only iterator to the first element
+	 */
+	ConstIterator begin() const {
+		return arr;
+	}
+
+	/**
+	 * @brief Returns a read-only iterator past the last element
+	 */
+	ConstIterator end() const {
+		return arr + size;
+	}
+
 	/**
 	 * @brief Returns the current number of elements in the vector
 	 * @return The size of the vector
 	 */
-	const int Size() const {
+	size_t Size() const {
 		return size;
 	}
 
@@ -101,7 +337,7 @@ public:
 	 * @brief Returns the current capacity of the vector
 	 * @return The maximum number of elements that can be stored without reallocation
 	 */
-	const int Capacity() const {
+	size_t Capacity() const {
 		return capacity;
 	}
 
@@ -127,9 +363,8 @@ int Back() {
 	bool RemoveBack() {
 		if (size == 0)
 			return false;
-		int back = arr[size - 1];
 		size -= 1;
-		if (size * 4 >= capacity) {
+		if (size * 4 < capacity) {
 			Reallocate(capacity / 2);
 		}
 		return true;
@@ -146,10 +381,10 @@ int Back() {
 	bool RemoveFront() {
 		if (size == 0)
 			return false;
-		for (int i = 1; i < size; i--)
+		for (size_t i = 1; i < size; i--)
 			Swap(arr[i], arr[i - 1]);
 		size -= 1;
-		if (size * 4 >= capacity) {
+		if (size * 4 < capacity) {
 			Reallocate(capacity / 2);
 		}
 	}
@@ -163,16 +398,16 @@ int Back() {
 	 * Time complexity: O(n²) in worst case due to repeated shifting
 	 */
 	void RemoveIf(std::function<bool(int, int)> (predicate)) {
-		for(int i = 0; i < size; ++i) {
-			if (predicate(i, arr[i])) {
-				for (int j = i + 1; j < size; ++j) {
+		for(size_t i = 0; i < size; ++i) {
+			if (predicate((int)i, arr[i])) {
+				for (size_t j = i + 1; j < size; ++j) {
 					Swap(arr[j], arr[j - 1]);
 				}
 				i -= 1;
 				size -= 1;
 			}
 		}
-		if (size * 4 >= capacity) {
+		if (size * 4 < capacity) {
 			Reallocate(capacity / 2);
 		}
 	}
@@ -184,8 +419,8 @@ int Back() {
 	 *
 	 * Asserts if index is out of bounds. Use for safe element access.
 	 */
-	int& At(int index) {
-		if (index >= size || index < 0)
+	int& At(size_t index) {
+		if (index >= size)
 			assert(false);
 		return arr[index];
 	}
@@ -196,7 +431,7 @@ int Back() {
 	 *
 	 * Provides convenient array-style syntax: vec[index]
 	 */
-	int& operator[](int index) {
+	int& operator[](size_t index) {
 		return At(index);
 	}
 
@@ -205,8 +440,8 @@ int Back() {
 	 * @param index The index of the element to access
 	 * @return Copy of the element at the given index
 	 */
-	const int operator[](int index) const {
-		if (index >= size || index < 0)
+	int operator[](size_t index) const {
+		if (index >= size)
 			assert(false);
 		return arr[index];
 	}
@@ -226,19 +461,38 @@ private:
 	 * @brief Reallocates the internal array with a new capacity
 	 * @param newCapacity The new capacity for the vector
 	 *
-	 * Copies existing elements to the new array and deallocates the old one.
-	 * Used internally for dynamic resizing.
+	 * Delegates to the allocator, which copies existing elements to a new
+	 * array (or grows the mapping in place for MappedAllocator). Used
+	 * internally for dynamic resizing. The capacity never drops below
+	 * MinCapacity so that 1.5x growth always makes progress.
 	 */
-	void Reallocate(int newCapacity)
+	void Reallocate(size_t newCapacity)
 	{
-		int* temp = new int[newCapacity];
-		if (arr) {
-			memcpy(temp, arr, sizeof(int) * size);
-			delete[] arr;
-		}
+		if (newCapacity < MinCapacity)
+			newCapacity = MinCapacity;
+		arr = (int*)allocator->Reallocate(arr, sizeof(int) * capacity,
+			sizeof(int) * newCapacity, sizeof(int) * size);
 		capacity = newCapacity;
-		arr = temp;
 	}
+
+	/**
+	 * @brief Ensures room for required elements, growing by at least 1.5x
+	 *
+	 * Keeps PushBack and repeated small Append/Insert calls amortized O(1)
+	 * per element instead of reallocating the whole array on every call.
+	 * Throws std::length_error if the byte size would not fit in size_t.
+	 */
+	void Grow(size_t required) {
+		if (required <= capacity)
+			return;
+		if (required > MaxSize)
+			throw std::length_error("Vector size exceeds the addressable range");
+		size_t grown = capacity + capacity / 2;
+		if (grown > MaxSize)
+			grown = MaxSize;
+		Reallocate(std::max(required, grown));
+	}
+
 	/**
 	 * @brief Utility function to swap two integers
 	 * @param a First integer to swap
@@ -252,7 +506,11 @@ private:
 		b = temp;
 	}
 
-	int size;      ///< Current number of elements in the vector
-	int capacity;  ///< Maximum number of elements that can be stored without reallocation
-	int* arr;      ///< Pointer to the dynamically allocated array
+	static const size_t MinCapacity = 6;                       ///< Smallest capacity the vector allocates
+	static const size_t MaxSize = SIZE_MAX / sizeof(int);     ///< Largest element count whose byte size fits in size_t
+
+	size_t size;           ///< Current number of elements in the vector
+	size_t capacity;       ///< Maximum number of elements that can be stored without reallocation
+	int* arr;              ///< Pointer to the dynamically allocated array
+	Allocator* allocator;  ///< Source of the array memory
 };
\ No newline at end of file
@@ -0,0 +1,185 @@
+/**
+ * @file WorkStealingDeque.h
+ * @brief Chase-Lev work-stealing deque
+ *
+ * A double-ended queue owned by one thread: the owner pushes and pops at
+ * the bottom (LIFO, good locality for fork-join recursion) while any
+ * number of thieves steal from the top (FIFO, taking the oldest and
+ * usually largest pieces of work).
+ *
+ * Features:
+ * - Owner Push/TryPop without atomic read-modify-write except on the last element
+ * - Lock-free TrySteal for other threads
+ * - Circular buffer that doubles when full
+ * - Follows the C11 formulation by Le, Pop, Cohen and Zappa Nardelli (PPoPP 2013)
+ */
+
+// filepath: e:\Playground\WorkStealingDeque.h
+#pragma once
+#include <atomic>
+#include <type_traits>
+#include <stdint.h>
+
+/**
+ * @class WorkStealingDeque
+ * @brief Single-owner, multi-thief deque of trivially copyable items
+ *
+ * bottom is only written by the owner and top is only advanced by CAS, so
+ * the owner pays for a CAS only when it races a thief for the last item.
+ * Items are stored in atomics because a thief may read a slot while the
+ * owner overwrites it; the thief then loses its CAS and discards the value.
+ *
+ * Buffers replaced by a grow are kept until destruction: a thief may still
+ * be reading one, and since capacity only doubles they add up to less than
+ * the current buffer.
+ */
+template<typename T>
+class WorkStealingDeque {
+	static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque items must be trivially copyable");
+
+public:
+	static const int64_t InitialCapacity = 64;  ///< Capacity of the first buffer
+
+	WorkStealingDeque()
+		: top(0), bottom(0), buffer(new Buffer(InitialCapacity, nullptr))
+	{
+	}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	/**
+	 * @brief Destructor - frees the current and all retired buffers
+	 *
+	 * No other thread may be using the deque.
+	 */
+	~WorkStealingDeque() {
+		Buffer* b = buffer.load(std::memory_order_relaxed);
+		while (b) {
+			Buffer* previous = b->previous;
+			delete b;
+			b = previous;
+		}
+	}
+
+	/**
+	 * @brief Pushes an item at the bottom (owner only)
+	 * @param item The item to push
+	 */
+	void Push(T item) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		Buffer* a = buffer.load(std::memory_order_relaxed);
+		if (b - t > a->mask)
+			a = Grow(a, t, b);
+		a->Put(b, item);
+		bottom.store(b + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Pops the most recently pushed item (owner only)
+	 * @param item Receives the item
+	 * @return false if the deque was empty or a thief took the last item
+	 */
+	bool TryPop(T& item) {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* a = buffer.load(std::memory_order_relaxed);
+		// Reserve the bottom slot before looking at top; seq_cst orders the
+		// store against the load so a thief and the owner cannot both take it.
+		bottom.store(b, std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_seq_cst);
+
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		item = a->Get(b);
+		if (t < b)
+			return true;
+
+		// Last item: race the thieves for it
+		bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	/**
+	 * @brief Steals the oldest item (any thread)
+	 * @param item Receives the item
+	 * @return false if the deque was empty or another thread got there first
+	 */
+	bool TrySteal(T& item) {
+		int64_t t = top.load(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_seq_cst);
+		if (t >= b)
+			return false;
+
+		Buffer* a = buffer.load(std::memory_order_acquire);
+		T value = a->Get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false;
+		item = value;
+		return true;
+	}
+
+	/**
+	 * @brief Returns the number of items
+	 * @return A snapshot; may be stale as soon as it is returned
+	 */
+	int64_t Size() const {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	/**
+	 * @brief Checks if the deque is empty
+	 * @return A snapshot; may be stale as soon as it is returned
+	 */
+	bool IsEmpty() const {
+		return Size() == 0;
+	}
+
+private:
+	/**
+	 * @brief Power-of-two circular array indexed by the unbounded top/bottom counters
+	 */
+	struct Buffer {
+		Buffer(int64_t capacity, Buffer* previous)
+			: mask(capacity - 1), items(new std::atomic<T>[capacity]), previous(previous)
+		{
+		}
+
+		~Buffer() {
+			delete[] items;
+		}
+
+		T Get(int64_t i) const {
+			return items[i & mask].load(std::memory_order_relaxed);
+		}
+
+		void Put(int64_t i, T item) {
+			items[i & mask].store(item, std::memory_order_relaxed);
+		}
+
+		int64_t mask;            ///< Capacity - 1
+		std::atomic<T>* items;   ///< Slots
+		Buffer* previous;        ///< Buffer this one replaced, kept for late thieves
+	};
+
+	/**
+	 * @brief Replaces the full buffer with one twice as large (owner only)
+	 * @return The new buffer
+	 */
+	Buffer* Grow(Buffer* old, int64_t t, int64_t b) {
+		Buffer* bigger = new Buffer((old->mask + 1) * 2, old);
+		for (int64_t i = t; i < b; ++i)
+			bigger->Put(i, old->Get(i));
+		buffer.store(bigger, std::memory_order_release);
+		return bigger;
+	}
+
+	alignas(64) std::atomic<int64_t> top;     ///< Next item to steal
+	alignas(64) std::atomic<int64_t> bottom;  ///< Next free slot (owner side)
+	std::atomic<Buffer*> buffer;              ///< Current circular buffer
+};
@@ -0,0 +1,133 @@
+// Three-stage pipeline benchmark: source -> transform -> sink.
+// The stages are coroutines connected by AsyncChannels (on one thread and
+// on a thread pool), compared with one OS thread per stage connected by
+// blocking MpmcQueues.
+//
+// Build: g++ -O2 -std=c++20 -pthread asyncChannelBenchmark.cpp -o asyncChannelBenchmark
+// Usage: ./asyncChannelBenchmark [items] [channelCapacity] [poolThreads]
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <stdlib.h>
+#include "AsyncChannel.h"
+#include "MpmcQueue.h"
+
+const int EndOfStream = -1;  // Sentinel for the blocking pipeline; items are non-negative
+
+AsyncTask source(AsyncChannel& out, int items) {
+	for (int i = 0; i < items; ++i)
+		co_await out.Push(i);
+	out.Close();
+}
+
+AsyncTask transform(AsyncChannel& in, AsyncChannel& out) {
+	while (std::optional<int> x = co_await in.Pop())
+		co_await out.Push(*x % 1000 * 3 + 1);
+	out.Close();
+}
+
+AsyncTask sink(AsyncChannel& in, long long& sum) {
+	while (std::optional<int> x = co_await in.Pop())
+		sum += *x;
+}
+
+/**
+ * Expected checksum of the pipeline
+ */
+long long expected(int items) {
+	long long sum = 0;
+	for (int i = 0; i < items; ++i)
+		sum += i % 1000 * 3 + 1;
+	return sum;
+}
+
+/**
+ * Runs the coroutine pipeline on a single thread
+ * @return Items per second
+ */
+double runSingleThread(int items, int capacity) {
+	SingleThreadExecutor executor;
+	AsyncChannel a(executor, capacity), b(executor, capacity);
+	long long sum = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	executor.Spawn(source(a, items));
+	executor.Spawn(transform(a, b));
+	executor.Spawn(sink(b, sum));
+	executor.Run();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (sum != expected(items))
+		std::cout << "checksum mismatch!\n";
+	return items / elapsed.count();
+}
+
+/**
+ * Runs the coroutine pipeline on a thread pool
+ * @return Items per second
+ */
+double runThreadPool(int items, int capacity, int threads) {
+	ThreadPoolExecutor executor(threads);
+	AsyncChannel a(executor, capacity), b(executor, capacity);
+	long long sum = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	executor.Spawn(source(a, items));
+	executor.Spawn(transform(a, b));
+	executor.Spawn(sink(b, sum));
+	executor.WaitIdle();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (sum != expected(items))
+		std::cout << "checksum mismatch!\n";
+	return items / elapsed.count();
+}
+
+/**
+ * Runs the pipeline with one thread per stage and blocking queues
+ * @return Items per second
+ */
+double runBlocking(int items, int capacity) {
+	MpmcQueue a(capacity), b(capacity);
+	long long sum = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	std::thread sourceThread([&a, items] {
+		for (int i = 0; i < items; ++i)
+			a.Push(i);
+		a.Push(EndOfStream);
+	});
+	std::thread transformThread([&a, &b] {
+		for (int x; (x = a.Pop()) != EndOfStream;)
+			b.Push(x % 1000 * 3 + 1);
+		b.Push(EndOfStream);
+	});
+	std::thread sinkThread([&b, &sum] {
+		for (int x; (x = b.Pop()) != EndOfStream;)
+			sum += x;
+	});
+	sourceThread.join();
+	transformThread.join();
+	sinkThread.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (sum != expected(items))
+		std::cout << "checksum mismatch!\n";
+	return items / elapsed.count();
+}
+
+int main(int argc, char** argv) {
+	int items = argc > 1 ? atoi(argv[1]) : 10000000;
+	int capacity = argc > 2 ? atoi(argv[2]) : 1024;
+	int threads = argc > 3 ? atoi(argv[3]) : 3;
+
+	std::cout << "3-stage pipeline, " << items << " items, capacity " << capacity << ", "
+		<< std::thread::hardware_concurrency() << " hardware threads\n";
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "  coroutines, 1 thread        : " << std::setw(7) << runSingleThread(items, capacity) / 1e6 << " M items/s\n";
+	std::cout << "  coroutines, " << std::setw(2) << threads << "-thread pool  : " << std::setw(7)
+		<< runThreadPool(items, capacity, threads) / 1e6 << " M items/s\n";
+	std::cout << "  thread per stage, blocking  : " << std::setw(7) << runBlocking(items, capacity) / 1e6 << " M items/s\n";
+}
@@ -0,0 +1,192 @@
+/**
+ * @file blockedFenwickTree.h
+ * @brief Fenwick Tree with a blocked, level-ordered layout for very large arrays
+ *
+ * Node i of a Fenwick tree sits on level ctz(i), and the nodes of level k
+ * are 2^(k+1) elements apart. In a plain array every node from level 3 up
+ * has its own cache line, from level 8 up its own page, and the
+ * power-of-two strides map the high levels onto a handful of cache sets:
+ * all multiples of 2^14 int64 nodes share one L2 set on a 2 MB, 16-way
+ * cache. Padding by a fixed amount only rescales those strides.
+ *
+ * This variant splits the tree at BlockBits:
+ * - Nodes below level BlockBits keep their plain position, so the first
+ *   steps of update(), querySum() and lowerBound() stay inside one 4 KB
+ *   block (levels 0-2 in one cache line), as in FenwickTree.
+ * - Nodes from level BlockBits up, i = j * 2^BlockBits, are stored level by
+ *   level in a second array: node j of level k goes to
+ *   levelStart[k] + (j >> (k + 1)). Each level is packed densely, so all
+ *   levels above k together take n / 2^k slots instead of n / 2^k cache
+ *   lines, and there are no power-of-two strides left among them.
+ *
+ * The packed upper levels pay off for lowerBound(), whose walk is a chain
+ * of dependent loads. Independent updates and prefix queries overlap their
+ * cache misses anyway, and the extra address arithmetic can make them
+ * slower than plain FenwickTree; run fenwickLayoutBenchmark on the target
+ * machine before choosing.
+ *
+ * Features:
+ * - Same interface and group parameters as FenwickTree, plus lowerBound
+ * - Optional transparent huge pages through MappedAllocator
+ * - O(n) construction, 64-bit indices
+ *
+ * Linux only (relies on MappedAllocator).
+ */
+
+// filepath: e:\Playground\blockedFenwickTree.h
+#pragma once
+#include "fenwickTree.h"
+#include "MappedAllocator.h"
+#include <new>
+#include <stddef.h>
+
+/**
+ * @class BlockedFenwickTree
+ * @brief 1-indexed Fenwick Tree over blocked, optionally huge-page backed storage
+ * @tparam T Value type
+ * @tparam Group Abelian group operation on T
+ */
+template<typename T = long long, typename Group = AdditiveGroup<T>>
+class BlockedFenwickTree {
+public:
+	static const int BlockBits = 9;  ///< 512 nodes per block: one 4 KB page of 8-byte values
+
+	/**
+	 * @brief Constructor for n elements that are all the identity
+	 * @param n Number of elements
+	 * @param hugePages Back the array with transparent huge pages
+	 */
+	explicit BlockedFenwickTree(size_t n, bool hugePages = false)
+		: BlockedFenwickTree(nullptr, n, hugePages)
+	{
+	}
+
+	/**
+	 * @brief Constructor from a raw array
+	 * @param values Pointer to n values (0-indexed), or nullptr for all-identity
+	 * @param n Number of values
+	 * @param hugePages Back the array with transparent huge pages
+	 *
+	 * Time complexity: O(n)
+	 */
+	BlockedFenwickTree(const T* values, size_t n, bool hugePages = false)
+		: allocator(hugePages), n(n)
+	{
+		size_t blocks = n >> BlockBits;
+		size_t start = n + 1;
+		for (int k = 0; k < MaxLevels; ++k) {
+			levelStart[k] = start;
+			start += (blocks >> k) - (blocks >> k >> 1);
+		}
+		bytes = start * sizeof(T);
+		data = (T*)allocator.Allocate(bytes, alignof(T));
+		for (size_t i = 1; i <= n; ++i)
+			new (&data[Slot(i)]) T(values ? values[i - 1] : Group::identity());
+		if (!values)
+			return;
+		for (size_t i = 1; i <= n; ++i) {
+			size_t parent = i + (i & (0 - i));
+			if (parent <= n)
+				data[Slot(parent)] = Group::combine(data[Slot(parent)], data[Slot(i)]);
+		}
+	}
+
+	BlockedFenwickTree(const BlockedFenwickTree&) = delete;
+	BlockedFenwickTree& operator=(const BlockedFenwickTree&) = delete;
+
+	~BlockedFenwickTree() {
+		for (size_t i = 1; i <= n; ++i)
+			data[Slot(i)].~T();
+		allocator.Deallocate(data, bytes, alignof(T));
+	}
+
+	/**
+	 * @brief Updates a single element by adding a delta value
+	 * @param index The 1-indexed position to update
+	 * @param delta The value to add
+	 *
+	 * Time complexity: O(log n)
+	 */
+	void update(size_t index, const T& delta) {
+		while (index <= n) {
+			T& node = data[Slot(index)];
+			node = Group::combine(node, delta);
+			index += index & (0 - index);
+		}
+	}
+
+	/**
+	 * @brief Calculates the sum of elements 1..index
+	 *
+	 * Time complexity: O(log n)
+	 */
+	T querySum(size_t index) const {
+		T result = Group::identity();
+		while (index > 0) {
+			result = Group::combine(result, data[Slot(index)]);
+			index &= index - 1;
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Calculates the sum of elements in [left, right] (1-indexed, inclusive)
+	 */
+	T queryRange(size_t left, size_t right) const {
+		return Group::combine(querySum(right), Group::inverse(querySum(left - 1)));
+	}
+
+	/**
+	 * @brief Finds the first prefix reaching a target
+	 * @return Smallest index i with querySum(i) >= target, or size() + 1 if none
+	 *
+	 * Requires non-negative elements, as FenwickTree::lowerBound does. The
+	 * walk is a chain of dependent loads, so it gains the most from the
+	 * packed upper levels. Time complexity: O(log n)
+	 */
+	size_t lowerBound(const T& target) const {
+		size_t position = 0;
+		T prefix = Group::identity();
+		for (size_t step = n ? size_t(1) << (63 - __builtin_clzll(n)) : 0; step > 0; step >>= 1) {
+			size_t next = position + step;
+			if (next <= n) {
+				T extended = Group::combine(prefix, data[Slot(next)]);
+				if (extended < target) {
+					position = next;
+					prefix = extended;
+				}
+			}
+		}
+		return position + 1;
+	}
+
+	/**
+	 * @brief Returns the number of elements
+	 */
+	size_t size() const {
+		return n;
+	}
+
+private:
+	static const int MaxLevels = 64;  ///< One level per bit of a size_t index
+
+	/**
+	 * @brief Physical position of logical node i (i >= 1)
+	 *
+	 * Computes both candidates and selects without a branch: update and
+	 * query paths switch between the two parts at unpredictable steps, and
+	 * a mispredict would serialize the cache misses of the walk.
+	 */
+	size_t Slot(size_t i) const {
+		size_t block = i >> BlockBits;
+		int level = __builtin_ctzll(block | (size_t(1) << 63));
+		size_t upper = levelStart[level] + (block >> level >> 1);
+		return (i & ((size_t(1) << BlockBits) - 1)) ? i : upper;
+	}
+
+	MappedAllocator allocator;     ///< Anonymous mapping, optionally with huge pages
+	size_t n;                      ///< Number of elements
+	size_t bytes;                  ///< Size of the mapping
+	size_t levelStart[MaxLevels];  ///< First slot of each upper level
+	T* data;                       ///< Lower levels in place (slots 0..n), then the upper levels
+};
@@ -0,0 +1,164 @@
+/**
+ * @file concurrentDisjointSet.h
+ * @brief Lock-free Union-Find for many threads
+ *
+ * Lets any number of threads union and query elements at the same time,
+ * e.g. to compute connected components with every thread handling its own
+ * slice of the edge list. Follows Anderson & Woll and Jayanti & Tarjan:
+ * roots are linked with a single CAS and finds compress paths with
+ * best-effort CASes that are never retried.
+ *
+ * Features:
+ * - CAS linking by index order, or by a random (hashed) priority
+ * - find with path splitting through relaxed atomics; it never waits on another thread
+ * - sameSet that is linearizable under concurrent unions
+ * - Component count for use once the unions are done
+ *
+ * Time complexity: O(log n) expected per operation with random priorities
+ */
+
+// filepath: e:\Playground\concurrentDisjointSet.h
+#pragma once
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <stdint.h>
+
+/**
+ * @class ConcurrentDisjointSet
+ * @brief Thread-safe Union-Find over elements 0..n-1
+ *
+ * A root is linked only by a CAS that still sees it as its own parent, and
+ * always under the root of higher priority, so the parent graph stays a
+ * forest no matter how unions interleave. Path splitting only ever moves a
+ * parent pointer further up the same tree, so a stale or lost compression
+ * CAS is harmless and need not be retried.
+ */
+class ConcurrentDisjointSet {
+public:
+	/**
+	 * @brief Constructor
+	 * @param n Number of elements; they are identified by 0..n-1
+	 * @param randomPriority Link by a hashed priority instead of index order
+	 *
+	 * Index order is simplest and works well on random inputs; random
+	 * priorities keep trees shallow on adversarial or sorted edge lists.
+	 */
+	explicit ConcurrentDisjointSet(int n, bool randomPriority = true)
+		: n(n), randomPriority(randomPriority), parent(new std::atomic<int>[n])
+	{
+		for (int i = 0; i < n; ++i)
+			parent[i].store(i, std::memory_order_relaxed);
+	}
+
+	ConcurrentDisjointSet(const ConcurrentDisjointSet&) = delete;
+	ConcurrentDisjointSet& operator=(const ConcurrentDisjointSet&) = delete;
+
+	/**
+	 * @brief Finds the current root of the set containing i
+	 * @param i Index of the element
+	 * @return A node that was the root of i's set at some point during the call
+	 *
+	 * Path splitting: each visited node is pointed at its grandparent with
+	 * one relaxed CAS, whose failure is ignored.
+	 */
+	int find(int i) {
+		for (;;) {
+			int p = parent[i].load(std::memory_order_relaxed);
+			if (p == i)
+				return i;
+			int grandparent = parent[p].load(std::memory_order_relaxed);
+			if (grandparent != p)
+				parent[i].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+			i = p;
+		}
+	}
+
+	/**
+	 * @brief Unites the sets containing elements a and b
+	 * @param a Index of first element
+	 * @param b Index of second element
+	 * @return true if this call merged two different sets
+	 *
+	 * Retries only when another thread linked one of the two roots first.
+	 */
+	bool unionElements(int a, int b) {
+		for (;;) {
+			a = find(a);
+			b = find(b);
+			if (a == b)
+				return false;
+			if (Priority(a) > Priority(b))
+				std::swap(a, b);
+			int expected = a;
+			if (parent[a].compare_exchange_strong(expected, b, std::memory_order_seq_cst))
+				return true;
+		}
+	}
+
+	/**
+	 * @brief Checks if two elements belong to the same set
+	 *
+	 * If the roots differ, the answer is "no" only when the first root is
+	 * still a root afterwards: it was then a root when the second find
+	 * returned, so at that instant the two sets really were different.
+	 */
+	bool sameSet(int a, int b) {
+		for (;;) {
+			a = find(a);
+			b = find(b);
+			if (a == b)
+				return true;
+			if (parent[a].load(std::memory_order_seq_cst) == a)
+				return false;
+		}
+	}
+
+	/**
+	 * @brief Counts the disjoint sets
+	 *
+	 * Time complexity: O(n). Only exact while no union is in progress.
+	 */
+	int componentCount() const {
+		int count = 0;
+		for (int i = 0; i < n; ++i)
+			count += parent[i].load(std::memory_order_relaxed) == i;
+		return count;
+	}
+
+	/**
+	 * @brief Returns the number of elements
+	 */
+	int elementCount() const {
+		return n;
+	}
+
+	/**
+	 * @brief Hints that element i is about to be accessed
+	 */
+	void prefetch(int i) const {
+		__builtin_prefetch(&parent[i], 1);
+	}
+
+private:
+	/**
+	 * @brief Link priority of a root; roots are linked under higher priorities
+	 *
+	 * The hash is a bijection on 32-bit values, so priorities never tie.
+	 */
+	uint32_t Priority(int i) const {
+		uint32_t x = (uint32_t)i;
+		if (!randomPriority)
+			return x;
+		x ^= x >> 16;
+		x *= 0x85ebca6bu;
+		x ^= x >> 13;
+		x *= 0xc2b2ae35u;
+		x ^= x >> 16;
+		return x;
+	}
+
+	int n;                                       ///< Number of elements
+	bool randomPriority;                         ///< Link by hashed priority instead of index
+	std::unique_ptr<std::atomic<int>[]> parent;  ///< Parent of each element
+};
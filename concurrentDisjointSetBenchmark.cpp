@@ -0,0 +1,106 @@
+// Scaling benchmark for ConcurrentDisjointSet: every thread unions its own
+// slice of one edge list, at 1, 2, 4, ... threads, on a uniformly random
+// graph and on a power-law graph (endpoints skewed towards a few hubs).
+// The sequential DisjointSet is the single-thread baseline and the
+// reference for the component count.
+//
+// Build: g++ -O2 -std=c++17 -pthread concurrentDisjointSetBenchmark.cpp -o concurrentDisjointSetBenchmark
+// Usage: ./concurrentDisjointSetBenchmark [vertices] [edgesPerVertex] [maxThreads]
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <stdlib.h>
+#include "concurrentDisjointSet.h"
+#include "disjointSet.h"
+
+typedef std::vector<std::pair<int, int>> EdgeList;
+
+/**
+ * Uniformly random endpoints
+ */
+EdgeList randomEdges(int n, long long m) {
+	std::mt19937_64 random(1);
+	EdgeList edges(m);
+	for (auto& e : edges)
+		e = { (int)(random() % n), (int)(random() % n) };
+	return edges;
+}
+
+/**
+ * Endpoints drawn as n * u^3 and then scattered by a fixed permutation, so
+ * vertex degrees follow a power law and a few hubs touch most edges
+ */
+EdgeList powerLawEdges(int n, long long m) {
+	std::mt19937_64 random(2);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::vector<int> permutation(n);
+	for (int i = 0; i < n; ++i)
+		permutation[i] = i;
+	std::shuffle(permutation.begin(), permutation.end(), random);
+
+	EdgeList edges(m);
+	for (auto& e : edges) {
+		int a = std::min(n - 1, (int)(n * std::pow(uniform(random), 3.0)));
+		int b = std::min(n - 1, (int)(n * std::pow(uniform(random), 3.0)));
+		e = { permutation[a], permutation[b] };
+	}
+	return edges;
+}
+
+/**
+ * Unions all edges with the given number of threads
+ * @return Edges per second
+ */
+double runConcurrent(int n, const EdgeList& edges, int threads, int expectedComponents) {
+	ConcurrentDisjointSet sets(n);
+	std::vector<std::thread> workers;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < threads; ++t) {
+		size_t begin = edges.size() * t / threads;
+		size_t end = edges.size() * (t + 1) / threads;
+		workers.emplace_back([&sets, &edges, begin, end] {
+			for (size_t k = begin; k < end; ++k)
+				sets.unionElements(edges[k].first, edges[k].second);
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (sets.componentCount() != expectedComponents)
+		std::cout << "component count mismatch!\n";
+	return edges.size() / elapsed.count();
+}
+
+void benchmark(const char* name, int n, const EdgeList& edges, int maxThreads) {
+	DisjointSet<> reference(n);
+	auto start = std::chrono::steady_clock::now();
+	reference.unionMany(edges);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << ": " << reference.componentCount() << " components\n";
+	std::cout << "  sequential DisjointSet : " << std::setw(7) << edges.size() / elapsed.count() / 1e6 << " M edges/s\n";
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+		std::cout << "  " << std::setw(2) << threads << " threads             : " << std::setw(7)
+			<< runConcurrent(n, edges, threads, (int)reference.componentCount()) / 1e6 << " M edges/s\n";
+}
+
+int main(int argc, char** argv) {
+	int n = argc > 1 ? atoi(argv[1]) : 1 << 24;
+	int edgesPerVertex = argc > 2 ? atoi(argv[2]) : 4;
+	int maxThreads = argc > 3 ? atoi(argv[3]) : 64;
+	long long m = (long long)n * edgesPerVertex;
+
+	std::cout << "ConcurrentDisjointSet, " << n << " vertices, " << m << " edges, "
+		<< std::thread::hardware_concurrency() << " hardware threads\n";
+	std::cout << std::fixed << std::setprecision(1);
+	benchmark("random", n, randomEdges(n, m), maxThreads);
+	benchmark("power-law", n, powerLawEdges(n, m), maxThreads);
+}
@@ -0,0 +1,130 @@
+// Throughput benchmark for ConcurrentFenwickTree: threads increment random
+// counters and read random prefix sums (one query per QueryEvery
+// operations) at 1, 2, 4, ... threads, for the atomic and sharded modes and
+// for a FenwickTree behind a mutex. Runs once with updates spread over all
+// counters and once with every update hitting a few hot counters. A
+// separate thread calls fold() every FoldInterval while the workers run, so
+// sharded queries keep hitting the retry path; it checks that the total
+// never decreases. The final total must equal the sum of all deltas.
+//
+// Build: g++ -O2 -std=c++17 -pthread concurrentFenwickBenchmark.cpp -o concurrentFenwickBenchmark
+// Usage: ./concurrentFenwickBenchmark [counters] [operationsPerThread] [maxThreads]
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <atomic>
+#include <stdlib.h>
+#include "concurrentFenwickTree.h"
+#include "fenwickTree.h"
+
+const int QueryEvery = 64;    ///< One prefix query per this many operations
+const size_t HotCounters = 8; ///< Counters hit by the contended workload
+const std::chrono::microseconds FoldInterval(500);  ///< Pause between concurrent folds
+
+/**
+ * FenwickTree guarded by a single mutex
+ */
+class LockedFenwickTree {
+public:
+	explicit LockedFenwickTree(size_t n) : tree(n) {}
+
+	void update(size_t index, long long delta) {
+		std::lock_guard<std::mutex> lock(mutex);
+		tree.update((int)index, delta);
+	}
+
+	long long querySum(size_t index) const {
+		std::lock_guard<std::mutex> lock(mutex);
+		return tree.querySum((int)index);
+	}
+
+	void fold() {}
+
+private:
+	FenwickTree<long long> tree;
+	mutable std::mutex mutex;
+};
+
+/**
+ * Runs the workload on tree with the given number of threads
+ * @return Operations per second
+ */
+template<typename Tree>
+double run(Tree& tree, size_t n, long long operations, int threads, bool hot) {
+	std::vector<std::thread> workers;
+	std::vector<long long> added(threads, 0);
+	std::atomic<bool> done(false);
+	auto start = std::chrono::steady_clock::now();
+	std::thread folder([&tree, &done, n] {
+		long long last = 0;
+		while (!done.load(std::memory_order_acquire)) {
+			tree.fold();
+			long long total = tree.querySum(n);
+			if (total < last)
+				std::cout << "total went backwards across fold!\n";
+			last = total;
+			std::this_thread::sleep_for(FoldInterval);
+		}
+	});
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&tree, &added, n, operations, hot, t] {
+			std::mt19937_64 random(t + 1);
+			long long sum = 0;
+			for (long long k = 0; k < operations; ++k) {
+				size_t index = (hot ? random() % HotCounters : random() % n) + 1;
+				if (k % QueryEvery == 0) {
+					tree.querySum(index);
+					continue;
+				}
+				long long delta = (long long)(random() & 7) + 1;
+				tree.update(index, delta);
+				sum += delta;
+			}
+			added[t] = sum;
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	done.store(true, std::memory_order_release);
+	folder.join();
+
+	tree.fold();
+	long long expected = 0;
+	for (long long sum : added)
+		expected += sum;
+	if (tree.querySum(n) != expected)
+		std::cout << "total mismatch!\n";
+	return operations * threads / elapsed.count();
+}
+
+void benchmark(const char* name, size_t n, long long operations, int maxThreads, bool hot) {
+	std::cout << name << "\n";
+	std::cout << "  threads" << std::setw(12) << "mutex" << std::setw(12) << "atomic" << std::setw(12) << "sharded" << "   (M ops/s)\n";
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		LockedFenwickTree locked(n);
+		ConcurrentFenwickTree<long long> atomic(n, ConcurrentFenwickTree<long long>::Mode::Atomic);
+		ConcurrentFenwickTree<long long> sharded(n, ConcurrentFenwickTree<long long>::Mode::Sharded, threads);
+		std::cout << "  " << std::setw(7) << threads
+			<< std::setw(12) << run(locked, n, operations, threads, hot) / 1e6
+			<< std::setw(12) << run(atomic, n, operations, threads, hot) / 1e6
+			<< std::setw(12) << run(sharded, n, operations, threads, hot) / 1e6 << "\n";
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t n = argc > 1 ? (size_t)atol(argv[1]) : 1 << 16;
+	long long operations = argc > 2 ? atoll(argv[2]) : 2000000;
+	int maxThreads = argc > 3 ? atoi(argv[3]) : 16;
+
+	std::cout << "ConcurrentFenwickTree, " << n << " counters, " << operations << " operations per thread, "
+		<< std::thread::hardware_concurrency() << " hardware threads\n";
+	std::cout << std::fixed << std::setprecision(1);
+	benchmark("uniform counters", n, operations, maxThreads, false);
+	benchmark("hot counters", n, operations, maxThreads, true);
+}
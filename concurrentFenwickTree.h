@@ -0,0 +1,202 @@
+/**
+ * @file concurrentFenwickTree.h
+ * @brief Thread-safe Fenwick Tree for high-rate counters
+ *
+ * Lets many threads increment counters and read prefix sums at the same
+ * time. Updates never block; queries take no locks, but in sharded mode
+ * they wait for a running fold() (see below). Two modes trade update cost
+ * against query cost:
+ *
+ * - Atomic: one tree of atomic nodes updated with relaxed fetch_add. Cheap
+ *   queries; updates to hot counters contend on the same cache lines.
+ * - Sharded: every thread adds into its own shard tree, so hot updates
+ *   stay in the updater's cache. Queries merge the main tree and all
+ *   shards; fold() moves the shards into the main tree to keep queries
+ *   from reading stale shards forever.
+ *
+ * Guarantees, for querySum(i) running concurrently with updates:
+ * - Every update at an index <= i is counted entirely or not at all: the
+ *   nodes read by a prefix query cover each position exactly once, and an
+ *   update adds its delta to exactly one of them (in each tree).
+ * - Updates that returned before the query started are counted; updates
+ *   that started after it returned are not. Updates that overlap the query
+ *   may be counted in any combination.
+ * - Queries are NOT linearizable. The nodes are read one at a time, not as
+ *   a snapshot, so a query can count update B but miss update A even
+ *   though A returned before B started, if both overlap the query. Two
+ *   concurrent queries may also disagree on which updates they saw.
+ * - fold() never makes a query count an update twice or miss a completed
+ *   one. A sharded query that starts while a fold is running waits, by
+ *   yielding, until the fold finishes, and one that overlaps a fold
+ *   retries. A fold takes O(shards * n), so queries stall for that long;
+ *   fold rarely, or fold from a thread whose queries can wait.
+ * Once all updates have returned, every query is exact.
+ *
+ * Time complexity: O(log n) per update; O(log n) per query in atomic
+ * mode, O(shards * log n) in sharded mode
+ */
+
+// filepath: e:\Playground\concurrentFenwickTree.h
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+#include <stddef.h>
+
+/**
+ * @class ConcurrentFenwickTree
+ * @brief 1-indexed Fenwick Tree of atomic integer counters
+ * @tparam T Integral counter type
+ */
+template<typename T = long long>
+class ConcurrentFenwickTree {
+	static_assert(std::is_integral<T>::value, "ConcurrentFenwickTree needs an integral type for fetch_add");
+
+public:
+	enum class Mode {
+		Atomic,   ///< Single tree of atomic nodes
+		Sharded   ///< Per-thread shard trees merged by queries and fold()
+	};
+
+	/**
+	 * @brief Constructor for n zero counters
+	 * @param n Number of counters
+	 * @param mode Atomic or Sharded
+	 * @param shards Number of shard trees in sharded mode (hardware concurrency if 0)
+	 *
+	 * Threads are assigned to shards round-robin; threads sharing a shard
+	 * remain correct since shard nodes are updated with fetch_add too.
+	 */
+	explicit ConcurrentFenwickTree(size_t n, Mode mode = Mode::Atomic, int shards = 0)
+		: n(n), treeMode(mode), main(NewTree(n)), generation(0)
+	{
+		if (mode == Mode::Atomic)
+			return;
+		if (shards <= 0)
+			shards = std::max(1u, std::thread::hardware_concurrency());
+		for (int s = 0; s < shards; ++s)
+			shardTrees.push_back(NewTree(n));
+	}
+
+	ConcurrentFenwickTree(const ConcurrentFenwickTree&) = delete;
+	ConcurrentFenwickTree& operator=(const ConcurrentFenwickTree&) = delete;
+
+	/**
+	 * @brief Adds delta to counter index (1-indexed)
+	 *
+	 * Time complexity: O(log n)
+	 */
+	void update(size_t index, T delta) {
+		std::atomic<T>* tree = treeMode == Mode::Atomic ? main.get() : shardTrees[ShardIndex()].get();
+		while (index <= n) {
+			tree[index].fetch_add(delta, std::memory_order_relaxed);
+			index += index & (0 - index);
+		}
+	}
+
+	/**
+	 * @brief Calculates the sum of counters 1..index
+	 *
+	 * In sharded mode the main tree and every shard are summed. The query
+	 * waits while a fold is running and starts over if a fold began during
+	 * it, so it can stall for the duration of a fold.
+	 */
+	T querySum(size_t index) const {
+		if (treeMode == Mode::Atomic)
+			return Prefix(main.get(), index);
+		for (;;) {
+			unsigned long long before = generation.load(std::memory_order_seq_cst);
+			if (before & 1) {
+				std::this_thread::yield();
+				continue;
+			}
+			T result = Prefix(main.get(), index);
+			for (const auto& shard : shardTrees)
+				result += Prefix(shard.get(), index);
+			if (generation.load(std::memory_order_seq_cst) == before)
+				return result;
+		}
+	}
+
+	/**
+	 * @brief Calculates the sum of counters in [left, right] (1-indexed, inclusive)
+	 *
+	 * Both prefixes are read under the same guarantees as querySum, but not
+	 * as one snapshot.
+	 */
+	T queryRange(size_t left, size_t right) const {
+		return querySum(right) - querySum(left - 1);
+	}
+
+	/**
+	 * @brief Moves every shard into the main tree (sharded mode)
+	 *
+	 * Node-wise addition preserves the Fenwick invariants, so the shards
+	 * are folded without rebuilding. Updates may run concurrently; calls to
+	 * fold() must not overlap each other. Sharded queries wait until the
+	 * fold completes. Time complexity: O(shards * n)
+	 */
+	void fold() {
+		if (treeMode == Mode::Atomic)
+			return;
+		generation.fetch_add(1, std::memory_order_seq_cst);
+		for (auto& shard : shardTrees)
+			for (size_t k = 1; k <= n; ++k) {
+				T moved = shard[k].exchange(0, std::memory_order_seq_cst);
+				if (moved)
+					main[k].fetch_add(moved, std::memory_order_seq_cst);
+			}
+		generation.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	/**
+	 * @brief Returns the number of counters
+	 */
+	size_t size() const {
+		return n;
+	}
+
+	/**
+	 * @brief Returns the mode chosen at construction
+	 */
+	Mode mode() const {
+		return treeMode;
+	}
+
+private:
+	typedef std::unique_ptr<std::atomic<T>[]> Tree;
+
+	static Tree NewTree(size_t n) {
+		Tree tree(new std::atomic<T>[n + 1]);
+		for (size_t k = 0; k <= n; ++k)
+			tree[k].store(0, std::memory_order_relaxed);
+		return tree;
+	}
+
+	static T Prefix(const std::atomic<T>* tree, size_t index) {
+		T result = 0;
+		while (index > 0) {
+			result += tree[index].load(std::memory_order_seq_cst);
+			index &= index - 1;
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Shard of the calling thread, assigned round-robin on first use
+	 */
+	size_t ShardIndex() const {
+		static std::atomic<size_t> nextThread(0);
+		thread_local size_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+		return thread % shardTrees.size();
+	}
+
+	size_t n;                                            ///< Number of counters
+	Mode treeMode;                                       ///< Atomic or Sharded
+	Tree main;                                           ///< Main tree (all updates in atomic mode)
+	std::vector<Tree> shardTrees;                        ///< Per-thread trees, sharded mode only
+	std::atomic<unsigned long long> generation;          ///< Odd while a fold is moving shards
+};
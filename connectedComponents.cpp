@@ -0,0 +1,64 @@
+// Driver for the streaming connected-components engine: labels the
+// components of a binary (u32, u32) edge file and prints the component
+// size histogram. Can also write a random edge file to try it on.
+//
+// Build: g++ -O2 -std=c++17 -pthread connectedComponents.cpp -o connectedComponents
+// Usage: ./connectedComponents <edgeFile> [threads] [vertices]
+//        ./connectedComponents --generate <edgeFile> <vertices> <edges>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "connectedComponents.h"
+
+/**
+ * Writes uniformly random edges, one buffer at a time
+ */
+int generate(const char* path, uint32_t vertices, uint64_t count) {
+	FILE* out = fopen(path, "wb");
+	if (!out) {
+		perror(path);
+		return 1;
+	}
+	std::mt19937_64 random(7);
+	std::vector<Edge> buffer(1 << 16);
+	while (count > 0) {
+		size_t n = (size_t)std::min<uint64_t>(count, buffer.size());
+		for (size_t k = 0; k < n; ++k)
+			buffer[k] = { (uint32_t)(random() % vertices), (uint32_t)(random() % vertices) };
+		fwrite(buffer.data(), sizeof(Edge), n, out);
+		count -= n;
+	}
+	fclose(out);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc >= 5 && strcmp(argv[1], "--generate") == 0)
+		return generate(argv[2], (uint32_t)atoll(argv[3]), (uint64_t)atoll(argv[4]));
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] << " <edgeFile> [threads] [vertices]\n"
+			<< "       " << argv[0] << " --generate <edgeFile> <vertices> <edges>\n";
+		return 1;
+	}
+	int threads = argc > 2 ? atoi(argv[2]) : 1;
+	int vertices = argc > 3 ? atoi(argv[3]) : 0;
+
+	std::unique_ptr<TaskScheduler> scheduler;
+	if (threads > 1)
+		scheduler.reset(new TaskScheduler(threads));
+
+	auto start = std::chrono::steady_clock::now();
+	ComponentLabels result = ConnectedComponents::Run(argv[1], vertices, scheduler.get());
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << result.labels.size() << " vertices, " << result.sizes.size() << " components, "
+		<< std::fixed << std::setprecision(2) << elapsed.count() << " s\n";
+	std::cout << "  size | components\n";
+	for (auto& bucket : result.histogram)
+		std::cout << "  " << std::setw(4) << bucket.first << " | " << bucket.second << "\n";
+}
@@ -0,0 +1,321 @@
+/**
+ * @file connectedComponents.h
+ * @brief Streaming connected-components labeling of binary edge files
+ *
+ * Labels the connected components of graphs whose edge lists are far
+ * larger than memory. The edge file is memory-mapped and streamed through
+ * a union-find in chunks, so peak memory is O(V): the union-find, the
+ * label array and the component sizes. Edges are never copied.
+ *
+ * Pipeline:
+ * 1. Map the file of (u32, u32) edges and read it sequentially
+ * 2. Union every edge, chunk by chunk, prefetching parent entries ahead;
+ *    with a TaskScheduler, chunks are claimed by parallel workers sharing a
+ *    ConcurrentDisjointSet, otherwise a DisjointSet is used
+ * 3. Compact the roots into dense labels 0..components-1 in parallel blocks
+ * 4. Count component sizes and build the size histogram
+ *
+ * Linux only (relies on mmap/madvise).
+ */
+
+// filepath: e:\Playground\connectedComponents.h
+#pragma once
+#include "disjointSet.h"
+#include "concurrentDisjointSet.h"
+#include "TaskScheduler.h"
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <stdint.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+/**
+ * @brief One edge as stored in the file: two little-endian u32 vertex ids
+ */
+struct Edge {
+	uint32_t u;  ///< First endpoint
+	uint32_t v;  ///< Second endpoint
+};
+
+/**
+ * @class MappedEdgeFile
+ * @brief Read-only memory mapping of a binary edge file
+ *
+ * Pages are read ahead sequentially and can be dropped from the mapping
+ * once processed, so the file contributes little to resident memory.
+ */
+class MappedEdgeFile {
+public:
+	/**
+	 * @brief Maps the file
+	 * @param path File of packed Edge records
+	 *
+	 * Throws std::system_error if the file cannot be opened or mapped.
+	 */
+	explicit MappedEdgeFile(const char* path) {
+		int fd = open(path, O_RDONLY);
+		if (fd < 0)
+			throw std::system_error(errno, std::generic_category(), path);
+		struct stat info;
+		if (fstat(fd, &info) != 0) {
+			int error = errno;
+			close(fd);
+			throw std::system_error(error, std::generic_category(), path);
+		}
+		bytes = (size_t)info.st_size;
+		if (bytes > 0) {
+			void* mapped = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapped == MAP_FAILED) {
+				int error = errno;
+				close(fd);
+				throw std::system_error(error, std::generic_category(), path);
+			}
+			edges = (const Edge*)mapped;
+			madvise(mapped, bytes, MADV_SEQUENTIAL);
+		}
+		close(fd);
+	}
+
+	MappedEdgeFile(const MappedEdgeFile&) = delete;
+	MappedEdgeFile& operator=(const MappedEdgeFile&) = delete;
+
+	~MappedEdgeFile() {
+		if (edges)
+			munmap((void*)edges, bytes);
+	}
+
+	/**
+	 * @brief Returns the mapped edges
+	 */
+	const Edge* Data() const {
+		return edges;
+	}
+
+	/**
+	 * @brief Returns the number of complete edges in the file
+	 */
+	size_t Size() const {
+		return bytes / sizeof(Edge);
+	}
+
+	/**
+	 * @brief Releases the pages of edges [first, first + count) from the mapping
+	 *
+	 * Only whole pages inside the range are released; touching the edges
+	 * again simply reads them back from the file.
+	 */
+	void Drop(size_t first, size_t count) const {
+		const size_t page = 4096;
+		uintptr_t begin = ((uintptr_t)(edges + first) + page - 1) & ~(uintptr_t)(page - 1);
+		uintptr_t end = (uintptr_t)(edges + first + count) & ~(uintptr_t)(page - 1);
+		if (begin < end)
+			madvise((void*)begin, end - begin, MADV_DONTNEED);
+	}
+
+private:
+	const Edge* edges = nullptr;  ///< Start of the mapping
+	size_t bytes = 0;             ///< File size
+};
+
+/**
+ * @brief Result of a connected-components run
+ */
+struct ComponentLabels {
+	std::vector<uint32_t> labels;                          ///< Dense component label of every vertex
+	std::vector<uint32_t> sizes;                           ///< Number of vertices in each component
+	std::vector<std::pair<uint32_t, uint64_t>> histogram;  ///< (component size, number of components), ascending
+};
+
+/**
+ * @class ConnectedComponents
+ * @brief Runs the mapped-file union-find pipeline
+ */
+class ConnectedComponents {
+public:
+	static const size_t DefaultChunkEdges = 1 << 20;  ///< Edges per chunk (8 MiB of file)
+	static const int CompactionBlock = 1 << 16;       ///< Vertices per compaction task
+
+	/**
+	 * @brief Labels the components of an edge file
+	 * @param path File of packed (u32, u32) edges
+	 * @param vertexCount Number of vertices, or 0 to take the largest id + 1
+	 * @param scheduler Pool for parallel chunk workers and compaction (sequential if null)
+	 * @param chunkEdges Edges streamed per chunk
+	 * @return Labels, component sizes and the size histogram
+	 *
+	 * Throws std::system_error if the file cannot be mapped and
+	 * std::out_of_range if an edge names a vertex >= vertexCount.
+	 */
+	static ComponentLabels Run(const char* path, int vertexCount = 0,
+		TaskScheduler* scheduler = nullptr, size_t chunkEdges = DefaultChunkEdges) {
+		MappedEdgeFile file(path);
+		if (vertexCount <= 0)
+			vertexCount = MaxVertex(file) + 1;
+		// Chunks start on page boundaries so processed ones can be dropped
+		chunkEdges = (chunkEdges + 511) / 512 * 512;
+
+		if (scheduler) {
+			ConcurrentDisjointSet sets(vertexCount);
+			ParallelUnion(file, sets, *scheduler, chunkEdges);
+			return Label(sets, vertexCount, scheduler);
+		}
+		DisjointSet<> sets((uint32_t)vertexCount);
+		for (size_t first = 0; first < file.Size(); first += chunkEdges)
+			UnionChunk(file, sets, first, std::min(chunkEdges, file.Size() - first));
+		return Label(sets, vertexCount, nullptr);
+	}
+
+private:
+	/**
+	 * @brief Scans the file once for the largest vertex id
+	 */
+	static int MaxVertex(const MappedEdgeFile& file) {
+		uint32_t largest = 0;
+		const Edge* edges = file.Data();
+		for (size_t k = 0; k < file.Size(); ++k)
+			largest = std::max(largest, std::max(edges[k].u, edges[k].v));
+		if (largest >= (uint32_t)INT_MAX)
+			throw std::out_of_range("vertex id does not fit the union-find index type");
+		return file.Size() ? (int)largest : -1;
+	}
+
+	/**
+	 * @brief Unions the edges of one chunk, prefetching parent entries ahead
+	 */
+	template<typename Sets>
+	static void UnionChunk(const MappedEdgeFile& file, Sets& sets, size_t first, size_t count) {
+		const Edge* edges = file.Data() + first;
+		uint32_t n = (uint32_t)sets.elementCount();
+		for (size_t k = 0; k < count; ++k) {
+			if (k + DisjointSet<>::PrefetchDistance < count) {
+				const Edge& ahead = edges[k + DisjointSet<>::PrefetchDistance];
+				if (ahead.u < n && ahead.v < n) {
+					sets.prefetch((int)ahead.u);
+					sets.prefetch((int)ahead.v);
+				}
+			}
+			if (edges[k].u >= n || edges[k].v >= n)
+				throw std::out_of_range("edge endpoint >= vertex count");
+			sets.unionElements((int)edges[k].u, (int)edges[k].v);
+		}
+		file.Drop(first, count);
+	}
+
+	/**
+	 * @brief Lets one task per worker claim chunks until the file is consumed
+	 */
+	static void ParallelUnion(const MappedEdgeFile& file, ConcurrentDisjointSet& sets,
+		TaskScheduler& scheduler, size_t chunkEdges) {
+		std::atomic<size_t> nextChunk(0);
+		std::atomic<bool> failed(false);
+		size_t chunks = (file.Size() + chunkEdges - 1) / chunkEdges;
+		{
+			TaskGroup group(scheduler);
+			for (int w = 0; w < scheduler.ThreadCount(); ++w) {
+				group.Spawn([&file, &sets, &nextChunk, &failed, chunks, chunkEdges] {
+					for (size_t c; !failed.load(std::memory_order_relaxed)
+						&& (c = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+						size_t first = c * chunkEdges;
+						try {
+							UnionChunk(file, sets, first, std::min(chunkEdges, file.Size() - first));
+						}
+						catch (const std::out_of_range&) {
+							failed.store(true, std::memory_order_relaxed);
+						}
+					}
+				});
+			}
+		}
+		if (failed.load())
+			throw std::out_of_range("edge endpoint >= vertex count");
+	}
+
+	/**
+	 * @brief Turns the union-find forest into dense labels, sizes and the histogram
+	 *
+	 * Pass 1 stores every vertex's root in labels, marks roots in a bitset
+	 * and counts them per block; a prefix sum over the blocks gives each
+	 * block its first label; pass 2 overwrites each root's entry with its
+	 * dense label; pass 3 lets every unmarked vertex copy the label from
+	 * its root's entry, so find runs only once per vertex. Blocks run as
+	 * parallel tasks when a scheduler is given; CompactionBlock is a
+	 * multiple of 64, so no two blocks share a bitset word.
+	 */
+	template<typename Sets>
+	static ComponentLabels Label(Sets& sets, int n, TaskScheduler* scheduler) {
+		ComponentLabels result;
+		result.labels.resize(n);
+		uint32_t* labels = result.labels.data();
+		int blocks = (n + CompactionBlock - 1) / CompactionBlock;
+		std::vector<uint32_t> blockRoots(blocks + 1, 0);
+		std::vector<uint64_t> isRoot((n + 63) / 64, 0);
+
+		ForEachBlock(scheduler, blocks, [&](int b) {
+			uint32_t roots = 0;
+			for (int v = b * CompactionBlock, end = std::min(n, v + CompactionBlock); v < end; ++v) {
+				labels[v] = (uint32_t)sets.find(v);
+				uint64_t root = labels[v] == (uint32_t)v;
+				isRoot[v >> 6] |= root << (v & 63);
+				roots += (uint32_t)root;
+			}
+			blockRoots[b + 1] = roots;
+		});
+		for (int b = 0; b < blocks; ++b)
+			blockRoots[b + 1] += blockRoots[b];
+
+		ForEachBlock(scheduler, blocks, [&](int b) {
+			uint32_t next = blockRoots[b];
+			for (int v = b * CompactionBlock, end = std::min(n, v + CompactionBlock); v < end; ++v)
+				if (IsMarked(isRoot, v))
+					labels[v] = next++;
+		});
+
+		ForEachBlock(scheduler, blocks, [&](int b) {
+			for (int v = b * CompactionBlock, end = std::min(n, v + CompactionBlock); v < end; ++v)
+				if (!IsMarked(isRoot, v))
+					labels[v] = labels[labels[v]];
+		});
+
+		result.sizes.assign(blockRoots[blocks], 0);
+		for (int v = 0; v < n; ++v)
+			result.sizes[labels[v]] += 1;
+
+		std::map<uint32_t, uint64_t> histogram;
+		for (uint32_t size : result.sizes)
+			histogram[size] += 1;
+		result.histogram.assign(histogram.begin(), histogram.end());
+		return result;
+	}
+
+	/**
+	 * @brief Checks bit v of a bitset stored in 64-bit words
+	 */
+	static bool IsMarked(const std::vector<uint64_t>& bits, int v) {
+		return (bits[v >> 6] >> (v & 63)) & 1;
+	}
+
+	/**
+	 * @brief Runs body(b) for every block, as parallel tasks if a scheduler is given
+	 */
+	template<typename Body>
+	static void ForEachBlock(TaskScheduler* scheduler, int blocks, Body body) {
+		if (!scheduler) {
+			for (int b = 0; b < blocks; ++b)
+				body(b);
+			return;
+		}
+		TaskGroup group(*scheduler);
+		for (int b = 0; b < blocks; ++b)
+			group.Spawn([&body, b] { body(b); });
+		group.Sync();
+	}
+};
@@ -2,95 +2,297 @@
  * @file disjointSet.h
  * @brief Union-Find (Disjoint Set) data structure implementation
  *
- * Implements a Union-Find data structure with path compression optimization.
- * Efficiently supports set operations: union and find.
+ * Implements a Union-Find data structure with union by size and path
+ * halving. Efficiently supports set operations: union and find.
  *
  * Features:
- * - Path compression for optimized find operations
- * - Union operation to merge sets
- * - Multiple constructor options
+ * - Index type as a template parameter: uint32_t (default) or uint64_t
+ *   for sets beyond 2^32 elements
+ * - Compact storage: one Index per element, holding the parent of a child
+ *   and the set size of a root
+ * - Iterative find with path halving (no recursion, safe for huge sets)
+ * - Union by size, so trees stay logarithmically shallow; setSize in O(α(n))
+ * - Incrementally maintained component count
+ * - Bulk unionMany/findMany that prefetch parent entries ahead of use
+ * - Optional payload that is referenced, never copied
+ * - Parallel initialization on a TaskScheduler for billions of elements
  *
- * Time complexity: Nearly O(1) for both union and find with path compression
+ * Time complexity: O(α(n)) amortized for both union and find
  */
 
 // filepath: e:\Playground\disjointSet.h
 #pragma once
+#include "TaskScheduler.h"
 #include <vector>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <stdexcept>
+#include <stddef.h>
+#include <stdint.h>
 
 /**
  * @class DisjointSet
  * @brief Union-Find data structure for managing disjoint sets
+ * @tparam Index Unsigned element index type
  *
  * Maintains a collection of disjoint sets and supports efficient
- * union and find operations with path compression optimization.
+ * union and find operations. A root's slot stores its set size tagged with
+ * RootTag (the top bit of Index) instead of a self-pointer, so sizes need
+ * no array of their own; this limits the element count to RootTag - 1.
+ * The array is allocated uninitialized and filled by the constructor, in
+ * parallel blocks when a scheduler is given.
  */
+template<typename Index = uint32_t>
 class DisjointSet {
+	static_assert(std::is_unsigned<Index>::value, "DisjointSet index type must be unsigned");
+
 public:
+	/**
+	 * @brief Distance (in elements) that the bulk operations prefetch ahead
+	 */
+	static const int PrefetchDistance = 16;
+
+	/**
+	 * @brief Elements initialized per task by the parallel constructor
+	 */
+	static const size_t InitBlock = 1 << 22;
+
+	/**
+	 * @brief Marks a slot as a root; the remaining bits hold the set size
+	 */
+	static const Index RootTag = Index(1) << (sizeof(Index) * 8 - 1);
+
+	/**
+	 * @brief Constructor for n elements without payload
+	 * @param n Number of elements; they are identified by 0..n-1
+	 *
+	 * Initializes each element as its own separate set.
+	 */
+	explicit DisjointSet(Index n)
+		: DisjointSet(n, nullptr)
+	{
+		Fill(0, n);
+	}
+
+	/**
+	 * @brief Constructor that initializes the arrays in parallel
+	 * @param n Number of elements; they are identified by 0..n-1
+	 * @param scheduler Pool whose workers fill blocks of InitBlock elements
+	 *
+	 * Each block is first touched by the worker that fills it, so on NUMA
+	 * machines the pages are spread across the nodes doing the work.
+	 */
+	DisjointSet(Index n, TaskScheduler& scheduler)
+		: DisjointSet(n, nullptr)
+	{
+		TaskGroup group(scheduler);
+		for (size_t first = 0; first < n; first += InitBlock) {
+			Index last = (Index)std::min<size_t>(n, first + InitBlock);
+			group.Spawn([this, first, last] { Fill((Index)first, last); });
+		}
+		group.Sync();
+	}
+
 	/**
 	 * @brief Constructor from C-style array
 	 * @param arr Pointer to array of integers
 	 * @param size Size of the array
 	 *
-	 * Initializes each element as its own separate set.
-	 * Each element becomes the parent of itself initially.
-	 */
-	DisjointSet(const int* arr, int size) {
-		data.resize(size);
-		parent.resize(size);
-		for(int i = 0; i < size; ++i){
-			data[i] = arr[i];
-			parent[i] = i;
-		}
+	 * Initializes each element as its own separate set. The array is
+	 * referenced as the payload, not copied, and must outlive the set.
+	 */
+	DisjointSet(const int* arr, Index size)
+		: DisjointSet(size, arr)
+	{
+		Fill(0, size);
 	}
 
 	/**
 	 * @brief Constructor from std::vector
 	 * @param vec Vector of integers to initialize the disjoint set
 	 *
-	 * Initializes each element as its own separate set.
-	 * More convenient than the array constructor for modern C++ usage.
+	 * Initializes each element as its own separate set. The vector is
+	 * referenced as the payload, not copied, and must outlive the set.
 	 */
-	DisjointSet(const std::vector<int> vec)
-		: data(vec)
+	DisjointSet(const std::vector<int>& vec)
+		: DisjointSet(vec.data(), (Index)vec.size())
 	{
-		parent.resize(vec.size());
-		for (int i = 0; i < vec.size(); ++i) {
-			parent[i] = i;
-		}
 	}
 
+	DisjointSet(std::vector<int>&&) = delete;  ///< Would leave the payload dangling
+
+	DisjointSet(DisjointSet&&) = default;
+	DisjointSet& operator=(DisjointSet&&) = default;
+
 	/**
 	 * @brief Finds the root/representative of the set containing element i
 	 * @param i Index of the element to find the root for
 	 * @return Index of the root element of the set containing i
 	 *
-	 * Uses path compression optimization: during traversal to root,
-	 * makes every node point directly to root for future efficiency.
-	 * Time complexity: Nearly O(1) amortized due to path compression
+	 * Uses path halving: every node visited is pointed at its grandparent,
+	 * which halves the path length in a single iterative pass.
+	 * Time complexity: O(α(n)) amortized
 	 */
-	int find(int i) {
-		if (parent[i] != i)
-			parent[i] = find(parent[i]);
-		return parent[i];
+	Index find(Index i) {
+		for (;;) {
+			Index up = parent[i];
+			if (up & RootTag)
+				return i;
+			Index grand = parent[up];
+			if (grand & RootTag)
+				return up;
+			parent[i] = grand;
+			i = grand;
+		}
 	}
 
 	/**
 	 * @brief Unites the sets containing elements a and b
 	 * @param a Index of first element
 	 * @param b Index of second element
+	 * @return true if the sets were different and have been merged
 	 *
-	 * Finds the roots of both elements and makes one root point to the other,
-	 * effectively merging the two sets into one.
-	 * Time complexity: Nearly O(1) amortized due to path compression in find()
+	 * Links the root of the smaller set under the root of the larger one.
+	 * Time complexity: O(α(n)) amortized
 	 */
-	void unionElements(int a, int b) {
+	bool unionElements(Index a, Index b) {
 		a = find(a);
 		b = find(b);
-		if (a != b) parent[a] = b;
+		if (a == b)
+			return false;
+		if (parent[a] < parent[b])
+			std::swap(a, b);
+		parent[a] += parent[b] & ~RootTag;
+		parent[b] = a;
+		components -= 1;
+		return true;
+	}
+
+	/**
+	 * @brief Checks if two elements belong to the same set
+	 */
+	bool sameSet(Index a, Index b) {
+		return find(a) == find(b);
+	}
+
+	/**
+	 * @brief Returns the number of elements in the set containing i
+	 *
+	 * Time complexity: O(α(n)) amortized
+	 */
+	Index setSize(Index i) {
+		return parent[find(i)] & ~RootTag;
+	}
+
+	/**
+	 * @brief Returns the current number of disjoint sets
+	 *
+	 * Time complexity: O(1), maintained by unionElements
+	 */
+	Index componentCount() const {
+		return components;
+	}
+
+	/**
+	 * @brief Returns the number of elements
+	 */
+	Index elementCount() const {
+		return n;
+	}
+
+	/**
+	 * @brief Returns the payload given to the constructor, or nullptr
+	 */
+	const int* payload() const {
+		return data;
+	}
+
+	/**
+	 * @brief Unites the endpoints of every edge
+	 * @param edges Array of (a, b) element pairs of any integer type
+	 * @param count Number of edges
+	 * @return Number of unions that merged two different sets
+	 *
+	 * While processing edge k the parent entries of edge k + PrefetchDistance
+	 * are prefetched, so on graphs larger than the cache the random parent
+	 * loads overlap instead of stalling one after another.
+	 */
+	template<typename Id>
+	size_t unionMany(const std::pair<Id, Id>* edges, size_t count) {
+		size_t merged = 0;
+		for (size_t k = 0; k < count; ++k) {
+			if (k + PrefetchDistance < count) {
+				prefetch(edges[k + PrefetchDistance].first);
+				prefetch(edges[k + PrefetchDistance].second);
+			}
+			merged += unionElements(edges[k].first, edges[k].second);
+		}
+		return merged;
+	}
+
+	template<typename Id>
+	size_t unionMany(const std::vector<std::pair<Id, Id>>& edges) {
+		return unionMany(edges.data(), edges.size());
+	}
+
+	/**
+	 * @brief Finds the roots of many elements
+	 * @param ids Elements to look up
+	 * @param roots Receives the root of each element
+	 * @param count Number of elements
+	 *
+	 * Prefetches parent entries PrefetchDistance lookups ahead.
+	 */
+	void findMany(const Index* ids, Index* roots, size_t count) {
+		for (size_t k = 0; k < count; ++k) {
+			if (k + PrefetchDistance < count)
+				prefetch(ids[k + PrefetchDistance]);
+			roots[k] = find(ids[k]);
+		}
+	}
+
+	std::vector<Index> findMany(const std::vector<Index>& ids) {
+		std::vector<Index> roots(ids.size());
+		findMany(ids.data(), roots.data(), ids.size());
+		return roots;
+	}
+
+	/**
+	 * @brief Hints that element i is about to be accessed
+	 *
+	 * Lets callers that stream their own edges overlap the parent loads.
+	 */
+	void prefetch(Index i) const {
+		__builtin_prefetch(&parent[i], 1);
 	}
 
 private:
-	std::vector<int> data;    ///< Stores the actual data elements
-	std::vector<int> parent;  ///< Stores parent pointers for each element (index -> parent index)
+	/**
+	 * @brief Allocates the array without initializing it
+	 */
+	DisjointSet(Index n, const int* data)
+		: data(data), parent(new Index[CheckedCount(n)]), n(n), components(n)
+	{
+	}
+
+	static Index CheckedCount(Index n) {
+		if (n >= RootTag)
+			throw std::length_error("DisjointSet needs a wider Index type for this many elements");
+		return n;
+	}
+
+	/**
+	 * @brief Makes elements [first, last) singleton sets
+	 */
+	void Fill(Index first, Index last) {
+		std::fill(parent.get() + first, parent.get() + last, RootTag | 1);
+	}
+
+	const int* data;                   ///< Optional payload, not owned
+	std::unique_ptr<Index[]> parent;   ///< Parent of a child; RootTag | set size for a root
+	Index n;                           ///< Number of elements
+	Index components;                  ///< Number of disjoint sets
 
-};
\ No newline at end of file
+};
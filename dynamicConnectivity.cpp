@@ -0,0 +1,134 @@
+// Driver for offline dynamic connectivity: reads a log of edge additions,
+// removals and connectivity queries and answers every query. Can also run
+// a random log and check the answers against rebuilding a DisjointSet.
+//
+// Log format: the vertex count, then one operation per line:
+//   + a b    add edge (a, b)
+//   - a b    remove edge (a, b)
+//   ? a b    are a and b connected?
+//
+// Build: g++ -O2 -std=c++17 dynamicConnectivity.cpp -o dynamicConnectivity
+// Usage: ./dynamicConnectivity <logFile | ->
+//        ./dynamicConnectivity --random <vertices> <operations> [check]
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+#include "dynamicConnectivity.h"
+#include "disjointSet.h"
+
+/**
+ * Answers the queries of a log read from in
+ */
+int run(std::istream& in) {
+	int n;
+	if (!(in >> n) || n < 0) {
+		std::cerr << "missing vertex count\n";
+		return 1;
+	}
+	DynamicConnectivity connectivity(n);
+	char op;
+	int a, b;
+	while (in >> op >> a >> b) {
+		if (a < 0 || a >= n || b < 0 || b >= n) {
+			std::cerr << "vertex out of range: " << op << " " << a << " " << b << "\n";
+			return 1;
+		}
+		if (op == '+')
+			connectivity.addEdge(a, b);
+		else if (op == '-') {
+			if (!connectivity.removeEdge(a, b)) {
+				std::cerr << "removing an edge that is not present: " << op << " " << a << " " << b << "\n";
+				return 1;
+			}
+		}
+		else if (op == '?')
+			connectivity.query(a, b);
+	}
+	std::vector<bool> answers = connectivity.solve();
+	std::string text;
+	text.reserve(answers.size() * 4);
+	for (bool connected : answers)
+		text += connected ? "YES\n" : "NO\n";
+	std::cout << text;
+	return 0;
+}
+
+/**
+ * Solves a random log and optionally checks every answer by rebuilding a DisjointSet
+ */
+int randomLog(int n, int operations, bool check) {
+	std::mt19937 random(11);
+	std::vector<std::pair<int, int>> edges;
+	std::vector<std::pair<int, int>> queries;
+	std::vector<std::vector<std::pair<int, int>>> present;
+	DynamicConnectivity connectivity(n);
+	for (int k = 0; k < operations; ++k) {
+		int kind = random() % 3;
+		int a = random() % n;
+		int b = random() % n;
+		if (kind == 0 || (kind == 1 && edges.empty())) {
+			connectivity.addEdge(a, b);
+			edges.push_back(std::make_pair(a, b));
+		}
+		else if (kind == 1) {
+			size_t victim = random() % edges.size();
+			connectivity.removeEdge(edges[victim].first, edges[victim].second);
+			edges[victim] = edges.back();
+			edges.pop_back();
+		}
+		else {
+			connectivity.query(a, b);
+			queries.push_back(std::make_pair(a, b));
+			if (check)
+				present.push_back(edges);
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<bool> answers = connectivity.solve();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	size_t connected = 0;
+	for (bool answer : answers)
+		connected += answer;
+	std::cout << n << " vertices, " << operations << " operations, " << queries.size() << " queries ("
+		<< connected << " connected), " << std::fixed << std::setprecision(3) << elapsed.count() << " s\n";
+
+	if (check) {
+		for (size_t q = 0; q < queries.size(); ++q) {
+			DisjointSet<> sets(n);
+			for (auto& edge : present[q])
+				sets.unionElements(edge.first, edge.second);
+			if (sets.sameSet(queries[q].first, queries[q].second) != answers[q]) {
+				std::cout << "mismatch! query " << q << "\n";
+				return 1;
+			}
+		}
+		std::cout << "all answers match a rebuilt DisjointSet\n";
+	}
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc >= 4 && strcmp(argv[1], "--random") == 0)
+		return randomLog(atoi(argv[2]), atoi(argv[3]), argc > 4 && strcmp(argv[4], "check") == 0);
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] << " <logFile | ->\n"
+			<< "       " << argv[0] << " --random <vertices> <operations> [check]\n";
+		return 1;
+	}
+	if (strcmp(argv[1], "-") == 0)
+		return run(std::cin);
+	std::ifstream in(argv[1]);
+	if (!in) {
+		std::cerr << "cannot open " << argv[1] << "\n";
+		return 1;
+	}
+	return run(in);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file dynamicConnectivity.h
+ * @brief Offline dynamic connectivity over a log of edge additions and removals
+ *
+ * Answers "are a and b connected right now?" for a recorded sequence of
+ * edge additions, edge removals and queries, without rebuilding a
+ * union-find for every change. Works offline: the whole log is recorded
+ * first and solve() answers every query at once.
+ *
+ * Features:
+ * - Segment tree over query time; each edge is stored in the O(log q)
+ *   nodes covering the interval in which it is alive
+ * - Depth-first walk of the tree that unions a node's edges on the way
+ *   down and rolls them back on the way up (RollbackDisjointSet)
+ * - Multi-edges: an edge added k times is alive until removed k times
+ *
+ * Time complexity: O(q log q log n) for q operations on n vertices
+ */
+
+// filepath: e:\Playground\dynamicConnectivity.h
+#pragma once
+#include "rollbackDisjointSet.h"
+#include <vector>
+#include <map>
+#include <utility>
+
+/**
+ * @class DynamicConnectivity
+ * @brief Records an add/remove/query log and answers the queries offline
+ *
+ * Time is measured in queries: an edge added after k queries were recorded
+ * and removed after j queries is alive for queries k..j-1.
+ */
+class DynamicConnectivity {
+public:
+	/**
+	 * @brief Constructor
+	 * @param n Number of vertices; they are identified by 0..n-1
+	 */
+	explicit DynamicConnectivity(int n)
+		: n(n)
+	{
+	}
+
+	/**
+	 * @brief Records the addition of edge (a, b)
+	 */
+	void addEdge(int a, int b) {
+		alive[Key(a, b)].push_back((int)queries.size());
+	}
+
+	/**
+	 * @brief Records the removal of edge (a, b)
+	 *
+	 * @return false, recording nothing, if the edge is not currently present
+	 */
+	bool removeEdge(int a, int b) {
+		auto it = alive.find(Key(a, b));
+		if (it == alive.end() || it->second.empty())
+			return false;
+		intervals.push_back(Interval{it->second.back(), (int)queries.size(), a, b});
+		it->second.pop_back();
+		if (it->second.empty())
+			alive.erase(it);
+		return true;
+	}
+
+	/**
+	 * @brief Records a connectivity query
+	 * @return Index of the query in the vector returned by solve()
+	 */
+	int query(int a, int b) {
+		queries.push_back(std::make_pair(a, b));
+		return (int)queries.size() - 1;
+	}
+
+	/**
+	 * @brief Answers every recorded query
+	 * @return For each query in recording order, whether a and b were connected
+	 *
+	 * Edges still present at the end of the log stay alive for all later queries.
+	 */
+	std::vector<bool> solve() {
+		int q = (int)queries.size();
+		std::vector<bool> answers(q);
+		if (q == 0)
+			return answers;
+
+		tree.assign(4 * q, std::vector<std::pair<int, int>>());
+		for (const Interval& interval : intervals)
+			Insert(1, 0, q, interval);
+		for (auto& entry : alive)
+			for (int start : entry.second)
+				Insert(1, 0, q, Interval{start, q, entry.first.first, entry.first.second});
+
+		RollbackDisjointSet sets(n);
+		Walk(1, 0, q, sets, answers);
+		tree.clear();
+		return answers;
+	}
+
+private:
+	/**
+	 * @brief Edge (a, b) alive for the queries in [begin, end)
+	 */
+	struct Interval {
+		int begin;  ///< First query that sees the edge
+		int end;    ///< First query after its removal
+		int a;      ///< Endpoint
+		int b;      ///< Endpoint
+	};
+
+	static std::pair<int, int> Key(int a, int b) {
+		return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+	}
+
+	/**
+	 * @brief Stores the edge in every maximal node covered by its interval
+	 */
+	void Insert(int node, int left, int right, const Interval& interval) {
+		if (interval.end <= left || right <= interval.begin || interval.begin >= interval.end)
+			return;
+		if (interval.begin <= left && right <= interval.end) {
+			tree[node].push_back(std::make_pair(interval.a, interval.b));
+			return;
+		}
+		int mid = left + (right - left) / 2;
+		Insert(2 * node, left, mid, interval);
+		Insert(2 * node + 1, mid, right, interval);
+	}
+
+	/**
+	 * @brief Applies the node's edges, answers the leaf query or recurses, then undoes the edges
+	 */
+	void Walk(int node, int left, int right, RollbackDisjointSet& sets, std::vector<bool>& answers) {
+		size_t snapshot = sets.snapshot();
+		for (const auto& edge : tree[node])
+			sets.unionElements(edge.first, edge.second);
+
+		if (right - left == 1) {
+			answers[left] = sets.sameSet(queries[left].first, queries[left].second);
+		}
+		else {
+			int mid = left + (right - left) / 2;
+			Walk(2 * node, left, mid, sets, answers);
+			Walk(2 * node + 1, mid, right, sets, answers);
+		}
+		sets.rollback(snapshot);
+	}
+
+	int n;                                                  ///< Number of vertices
+	std::vector<std::pair<int, int>> queries;               ///< Recorded queries
+	std::vector<Interval> intervals;                        ///< Edges already removed
+	std::map<std::pair<int, int>, std::vector<int>> alive;  ///< Present edges -> start times (one per copy)
+	std::vector<std::vector<std::pair<int, int>>> tree;     ///< Edges stored at each segment tree node
+};
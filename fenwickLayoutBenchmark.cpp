@@ -0,0 +1,141 @@
+// Benchmark for the FenwickTree memory layouts: random point updates,
+// random prefix queries and random lowerBound walks on the plain layout
+// and the blocked layout, each with and without transparent huge pages.
+// Every variant runs the same operations and must produce the same
+// checksum.
+//
+// Each tree of n int64 counters needs about 8n bytes (8 GB at 1e9).
+//
+// Build: g++ -O2 -std=c++17 fenwickLayoutBenchmark.cpp -o fenwickLayoutBenchmark
+// Usage: ./fenwickLayoutBenchmark [operations] [size...]   (default sizes 1e6 1e8 1e9)
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include "fenwickTree.h"
+#include "blockedFenwickTree.h"
+
+struct Result {
+	double updateNs;     ///< Nanoseconds per update
+	double queryNs;      ///< Nanoseconds per query
+	double searchNs;     ///< Nanoseconds per lowerBound
+	long long checksum;  ///< Sum of all query results
+};
+
+/**
+ * Plain Fenwick layout on a MappedAllocator block, so huge pages can be
+ * measured apart from the blocked layout
+ */
+struct MappedFenwickTree {
+	MappedFenwickTree(size_t n, bool hugePages)
+		: allocator(hugePages), n(n), bytes((n + 1) * sizeof(long long))
+	{
+		data = (long long*)allocator.Allocate(bytes);
+		memset(data, 0, bytes);
+	}
+
+	~MappedFenwickTree() {
+		allocator.Deallocate(data, bytes);
+	}
+
+	void update(size_t index, long long delta) {
+		for (; index <= n; index += index & (0 - index))
+			data[index] += delta;
+	}
+
+	long long querySum(size_t index) const {
+		long long result = 0;
+		for (; index > 0; index &= index - 1)
+			result += data[index];
+		return result;
+	}
+
+	size_t lowerBound(long long target) const {
+		size_t position = 0;
+		long long prefix = 0;
+		for (size_t step = size_t(1) << (63 - __builtin_clzll(n)); step > 0; step >>= 1) {
+			size_t next = position + step;
+			if (next <= n && prefix + data[next] < target) {
+				position = next;
+				prefix += data[next];
+			}
+		}
+		return position + 1;
+	}
+
+	MappedAllocator allocator;
+	size_t n;
+	size_t bytes;
+	long long* data;
+};
+
+/**
+ * Runs operations random updates, then as many random prefix queries,
+ * then as many lowerBound searches for random targets
+ */
+template<typename Tree>
+Result run(Tree& tree, size_t n, size_t operations) {
+	Result result;
+	std::mt19937_64 random(17);
+	auto start = std::chrono::steady_clock::now();
+	for (size_t k = 0; k < operations; ++k)
+		tree.update(random() % n + 1, (long long)(random() & 0xff));
+	auto updated = std::chrono::steady_clock::now();
+	result.checksum = 0;
+	for (size_t k = 0; k < operations; ++k)
+		result.checksum += tree.querySum(random() % n + 1);
+	auto queried = std::chrono::steady_clock::now();
+	long long total = tree.querySum(n);
+	for (size_t k = 0; k < operations; ++k)
+		result.checksum += (long long)tree.lowerBound((long long)(random() % (total + 1)) + 1);
+	auto searched = std::chrono::steady_clock::now();
+	result.updateNs = std::chrono::duration<double, std::nano>(updated - start).count() / operations;
+	result.queryNs = std::chrono::duration<double, std::nano>(queried - updated).count() / operations;
+	result.searchNs = std::chrono::duration<double, std::nano>(searched - queried).count() / operations;
+	return result;
+}
+
+void report(const char* name, const Result& result, long long expected) {
+	std::cout << "  " << std::setw(18) << name
+		<< std::setw(12) << result.updateNs
+		<< std::setw(12) << result.queryNs
+		<< std::setw(12) << result.searchNs
+		<< (result.checksum != expected ? "   mismatch!" : "") << "\n";
+}
+
+int main(int argc, char** argv) {
+	size_t operations = argc > 1 ? (size_t)atof(argv[1]) : 10000000;
+	std::vector<size_t> sizes;
+	for (int a = 2; a < argc; ++a)
+		sizes.push_back((size_t)atof(argv[a]));
+	if (sizes.empty())
+		sizes = { 1000000, 100000000, 1000000000 };
+
+	std::cout << std::fixed << std::setprecision(1);
+	for (size_t n : sizes) {
+		std::cout << "n = " << n << ", " << operations << " updates and queries\n";
+		std::cout << "  " << std::setw(18) << "layout" << std::setw(12) << "update ns" << std::setw(12) << "query ns" << std::setw(12) << "search ns" << "\n";
+		Result plain;
+		{
+			FenwickTree<long long> tree(n);
+			plain = run(tree, n, operations);
+		}
+		report("plain", plain, plain.checksum);
+		{
+			MappedFenwickTree tree(n, true);
+			report("plain+hugepages", run(tree, n, operations), plain.checksum);
+		}
+		{
+			BlockedFenwickTree<long long> tree(n);
+			report("blocked", run(tree, n, operations), plain.checksum);
+		}
+		{
+			BlockedFenwickTree<long long> tree(n, true);
+			report("blocked+hugepages", run(tree, n, operations), plain.checksum);
+		}
+	}
+}
@@ -6,33 +6,108 @@
  * - Point updates: modify a single element
  * - Range queries: calculate prefix sums and range sums
  *
- * Time complexity: O(log n) for both updates and queries
+ * Features:
+ * - Value type as a template parameter (int64_t, double, ...)
+ * - Any abelian group through a supplied operation type (AdditiveGroup by default)
+ * - O(n) in-place construction
+ * - Construction from an iterator range or a raw pointer, without an
+ *   intermediate std::vector<int>
+ * - Order statistics for frequency trees over a bounded key range:
+ *   lowerBound, kth, rank, insert/erase and a batched kthMany, each a
+ *   single O(log n) top-down walk
+ * - Batched applyUpdates (one O(n) sweep for dense batches) and queryMany
+ *   (prefix walks prefetched ahead)
+ *
+ * Time complexity: O(log n) for both updates and queries, O(n) to build
  * Space complexity: O(n)
  */
 
+// filepath: e:\Playground\fenwickTree.h
 #pragma once
 #include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <stddef.h>
+
+/**
+ * @brief Group operation for FenwickTree: ordinary addition
+ *
+ * A custom group supplies the same three static functions. combine must
+ * be associative and commutative; inverse(a) must undo combine with a.
+ */
+template<typename T>
+struct AdditiveGroup {
+	static T identity() { return T(); }
+	static T combine(const T& a, const T& b) { return a + b; }
+	static T inverse(const T& a) { return -a; }
+};
 
 /**
  * @class FenwickTree
  * @brief Binary Indexed Tree implementation for efficient range sum queries
+ * @tparam T Value type
+ * @tparam Group Abelian group operation on T
  *
  * This implementation supports 1-indexed operations for easier mathematical operations.
  * The tree is built from a given array and allows efficient updates and queries.
  */
+template<typename T = int, typename Group = AdditiveGroup<T>>
 class FenwickTree {
 public:
+	/**
+	 * @brief Constructor for n elements that are all the identity
+	 */
+	explicit FenwickTree(size_t n)
+		: data(n + 1, Group::identity())
+	{
+	}
+
 	/**
 	 * @brief Constructor that builds the Fenwick Tree from an input array
 	 * @param original The original array to build the tree from (0-indexed)
 	 *
 	 * Converts 0-indexed input array to 1-indexed Fenwick Tree representation.
-	 * Time complexity: O(n log n)
+	 * Time complexity: O(n)
 	 */
-	FenwickTree(const std::vector<int>& original) {
-		data.resize(original.size() + 1, 0);
-		for (int i = 1; i <= original.size(); ++i)
-			update(i, original[i - 1]);
+	FenwickTree(const std::vector<T>& original)
+		: FenwickTree(original.begin(), original.end())
+	{
+	}
+
+	/**
+	 * @brief Constructor from a raw array
+	 * @param values Pointer to the first of n values (0-indexed)
+	 * @param n Number of values
+	 *
+	 * Time complexity: O(n)
+	 */
+	FenwickTree(const T* values, size_t n)
+		: FenwickTree(values, values + n)
+	{
+	}
+
+	/**
+	 * @brief Constructor from an iterator range
+	 * @param first Iterator to the first value (0-indexed)
+	 * @param last Iterator past the last value
+	 *
+	 * Copies the values into place, then lets every node push its
+	 * partial sum to its parent i + lsb(i) once, in increasing order.
+	 * Time complexity: O(n)
+	 */
+	template<typename Iterator>
+	FenwickTree(Iterator first, Iterator last) {
+		data.reserve(std::distance(first, last) + 1);
+		data.push_back(Group::identity());
+		for (; first != last; ++first)
+			data.push_back(T(*first));
+		size_t n = data.size() - 1;
+		for (size_t i = 1; i <= n; ++i) {
+			size_t parent = i + (i & (0 - i));
+			if (parent <= n)
+				data[parent] = Group::combine(data[parent], data[i]);
+		}
 	}
 
 	/**
@@ -42,10 +117,10 @@ public:
 	 *
 	 * Time complexity: O(log n)
 	 */
-	void update(int index, int delta) {
-		while (index <= data.size()) {
-			data[index] += delta;
-			index += leastSegnificantBit(index);
+	void update(int index, const T& delta) {
+		while (index < (int)data.size()) {
+			data[index] = Group::combine(data[index], delta);
+			index += leastSignificantBit(index);
 		}
 	}
 
@@ -56,11 +131,11 @@ public:
 	 *
 	 * Time complexity: O(log n)
 	 */
-	int querySum(int index) {
-		int result = 0;
+	T querySum(int index) const {
+		T result = Group::identity();
 		while(index > 0) {
-			result += data[index];
-			index -= leastSegnificantBit(index);
+			result = Group::combine(result, data[index]);
+			index -= leastSignificantBit(index);
 		}
 		return result;
 	}
@@ -74,11 +149,216 @@ public:
 	 * Uses the principle: rangeSum(left, right) = prefixSum(right) - prefixSum(left-1)
 	 * Time complexity: O(log n)
 	 */
-	int queryRange(int left, int right) {
-		return querySum(right) - querySum(left - 1);
+	T queryRange(int left, int right) const {
+		return Group::combine(querySum(right), Group::inverse(querySum(left - 1)));
+	}
+
+	/**
+	 * @brief Returns the number of elements
+	 */
+	int size() const {
+		return (int)data.size() - 1;
+	}
+
+	/**
+	 * @brief Finds the first prefix reaching a target
+	 * @param target Prefix sum to reach
+	 * @return Smallest index i with querySum(i) >= target, or size() + 1 if none
+	 *
+	 * Requires non-negative elements, so that prefix sums are monotonic.
+	 * Binary lifting: descends from the highest power of two, stepping
+	 * over every node whose partial sum keeps the prefix below target,
+	 * instead of binary searching with querySum.
+	 * Time complexity: O(log n)
+	 */
+	int lowerBound(const T& target) const {
+		int position = 0;
+		T prefix = Group::identity();
+		for (int step = highestStep(); step > 0; step >>= 1) {
+			int next = position + step;
+			if (next < (int)data.size()) {
+				T extended = Group::combine(prefix, data[next]);
+				if (extended < target) {
+					position = next;
+					prefix = extended;
+				}
+			}
+		}
+		return position + 1;
+	}
+
+	/**
+	 * @brief Returns the k-th smallest key of a frequency tree (k is 1-based)
+	 *
+	 * Element i holds the count of key i. Returns size() + 1 if fewer than
+	 * k keys are stored. Time complexity: O(log n)
+	 */
+	int kth(const T& k) const {
+		return lowerBound(k);
+	}
+
+	/**
+	 * @brief Returns the number of stored keys smaller than key
+	 */
+	T rank(int key) const {
+		return querySum(key - 1);
+	}
+
+	/**
+	 * @brief Adds count copies of key to a frequency tree
+	 */
+	void insert(int key, const T& count = T(1)) {
+		update(key, count);
+	}
+
+	/**
+	 * @brief Removes count copies of key from a frequency tree
+	 *
+	 * The caller must not remove more copies than are stored.
+	 */
+	void erase(int key, const T& count = T(1)) {
+		update(key, Group::inverse(count));
+	}
+
+	/**
+	 * @brief Answers many kth queries
+	 * @param ks Ranks to look up (1-based)
+	 * @param keys Receives kth(ks[j]) for every query
+	 * @param count Number of queries
+	 *
+	 * Walks KthLanes queries down the tree together, one level at a time.
+	 * The lanes' loads are independent, so their cache misses overlap, and
+	 * the upper levels they all touch stay in cache.
+	 */
+	void kthMany(const T* ks, int* keys, size_t count) const {
+		const int top = highestStep();
+		for (size_t first = 0; first < count; first += KthLanes) {
+			int lanes = (int)std::min<size_t>(KthLanes, count - first);
+			int position[KthLanes];
+			T prefix[KthLanes];
+			for (int j = 0; j < lanes; ++j) {
+				position[j] = 0;
+				prefix[j] = Group::identity();
+			}
+			for (int step = top; step > 0; step >>= 1) {
+				for (int j = 0; j < lanes; ++j) {
+					int next = position[j] + step;
+					if (next < (int)data.size()) {
+						T extended = Group::combine(prefix[j], data[next]);
+						if (extended < ks[first + j]) {
+							position[j] = next;
+							prefix[j] = extended;
+						}
+					}
+				}
+			}
+			for (int j = 0; j < lanes; ++j)
+				keys[first + j] = position[j] + 1;
+		}
+	}
+
+	std::vector<int> kthMany(const std::vector<T>& ks) const {
+		std::vector<int> keys(ks.size());
+		kthMany(ks.data(), keys.data(), ks.size());
+		return keys;
+	}
+
+	/**
+	 * @brief Adds many deltas at once
+	 * @param updates (1-indexed position, delta) pairs; positions may repeat
+	 * @param count Number of updates
+	 *
+	 * Updates whose position lies outside 1..size() are skipped, on both
+	 * paths, so the result never depends on which path the batch takes.
+	 * Dense batches (count * log n >= 3n) scatter the deltas into a
+	 * scratch array and sweep it once in increasing order, pushing each
+	 * node's accumulated delta to its parent as in the O(n) build: every
+	 * ancestor is written exactly once and memory is streamed in order.
+	 * Sparse batches share few ancestors beyond the top levels, which stay
+	 * cached, so they are applied one by one with prefetching; sorting them
+	 * costs more than it saves.
+	 * Time complexity: O(min(n, k log n))
+	 */
+	void applyUpdates(const std::pair<int, T>* updates, size_t count) {
+		size_t n = data.size() - 1;
+		if (count * (treeHeight() + 1) < 3 * n) {
+			for (size_t k = 0; k < count; ++k) {
+				if (k + PrefetchDistance < count && inRange(updates[k + PrefetchDistance].first))
+					__builtin_prefetch(&data[updates[k + PrefetchDistance].first], 1);
+				if (inRange(updates[k].first))
+					update(updates[k].first, updates[k].second);
+			}
+			return;
+		}
+
+		std::vector<T> delta(data.size(), Group::identity());
+		for (size_t k = 0; k < count; ++k)
+			if (inRange(updates[k].first))
+				delta[updates[k].first] = Group::combine(delta[updates[k].first], updates[k].second);
+		for (size_t i = 1; i <= n; ++i) {
+			size_t parent = i + (i & (0 - i));
+			if (parent <= n)
+				delta[parent] = Group::combine(delta[parent], delta[i]);
+			data[i] = Group::combine(data[i], delta[i]);
+		}
+	}
+
+	void applyUpdates(const std::vector<std::pair<int, T>>& updates) {
+		applyUpdates(updates.data(), updates.size());
+	}
+
+	/**
+	 * @brief Calculates many prefix sums
+	 * @param indices 1-indexed positions
+	 * @param sums Receives querySum(indices[j]) for every query
+	 * @param count Number of queries
+	 *
+	 * The first node of a prefix walk is the one likely to miss the cache;
+	 * the later nodes cover long ranges, are few, and are shared by most
+	 * queries. So the first node of query j + PrefetchDistance is
+	 * prefetched while query j runs.
+	 */
+	void queryMany(const int* indices, T* sums, size_t count) const {
+		for (size_t k = 0; k < count; ++k) {
+			if (k + PrefetchDistance < count)
+				__builtin_prefetch(&data[indices[k + PrefetchDistance]]);
+			sums[k] = querySum(indices[k]);
+		}
+	}
+
+	std::vector<T> queryMany(const std::vector<int>& indices) const {
+		std::vector<T> sums(indices.size());
+		queryMany(indices.data(), sums.data(), indices.size());
+		return sums;
 	}
 
 private:
+	static const int KthLanes = 16;          ///< Queries walked together by kthMany
+	static const int PrefetchDistance = 16;  ///< Batch entries prefetched ahead
+
+	/**
+	 * @brief Returns the largest power of two <= size(), or 0 if empty
+	 */
+	int highestStep() const {
+		int n = size();
+		return n > 0 ? 1 << (31 - __builtin_clz((unsigned)n)) : 0;
+	}
+
+	/**
+	 * @brief Checks that a 1-indexed position lies in 1..size()
+	 */
+	bool inRange(int index) const {
+		return index > 0 && index < (int)data.size();
+	}
+
+	/**
+	 * @brief Returns floor(log2(size())), the height of the tree
+	 */
+	size_t treeHeight() const {
+		int n = size();
+		return n > 0 ? 31 - __builtin_clz((unsigned)n) : 0;
+	}
+
 	/**
 	 * @brief Calculates the least significant bit of a number
 	 * @param v The input value
@@ -87,7 +367,7 @@ private:
 	 * Uses bit manipulation: v & -v isolates the rightmost set bit.
 	 * This is crucial for navigating the Fenwick Tree structure.
 	 */
-	int leastSegnificantBit(int v) {
+	static int leastSignificantBit(int v) {
 		return v & -v;    }
 
 	/**
@@ -97,5 +377,8 @@ private:
 	 * Each index stores a partial sum that covers a specific range
 	 * determined by the binary representation of the index.
 	 */
-	std::vector<int> data;
-};
\ No newline at end of file
+	std::vector<T> data;
+};
+
+template<typename Iterator>
+FenwickTree(Iterator, Iterator) -> FenwickTree<typename std::iterator_traits<Iterator>::value_type>;
@@ -0,0 +1,131 @@
+/**
+ * @file fenwickTree2D.h
+ * @brief Two-dimensional Fenwick Tree for rectangle sums
+ *
+ * Supports point updates and sums over any axis-aligned rectangle of a
+ * rows x cols grid, e.g. (time bucket, shard) counters.
+ *
+ * Features:
+ * - Single contiguous row-major allocation of (rows + 1) x (cols + 1) nodes
+ * - O(rows * cols) construction from a row-major array
+ * - Value type and abelian group as in FenwickTree
+ *
+ * Time complexity: O(log rows * log cols) for updates and queries
+ * Space complexity: O(rows * cols)
+ */
+
+// filepath: e:\Playground\fenwickTree2D.h
+#pragma once
+#include "fenwickTree.h"
+#include <vector>
+#include <stddef.h>
+
+/**
+ * @class FenwickTree2D
+ * @brief Binary Indexed Tree over a 1-indexed grid
+ * @tparam T Value type
+ * @tparam Group Abelian group operation on T
+ *
+ * Node (r, c) covers rows (r - lsb(r), r] and columns (c - lsb(c), c];
+ * it is stored at data[r * (cols + 1) + c]. Row 0 and column 0 are unused.
+ */
+template<typename T = long long, typename Group = AdditiveGroup<T>>
+class FenwickTree2D {
+public:
+	/**
+	 * @brief Constructor for an all-identity grid
+	 */
+	FenwickTree2D(int rows, int cols)
+		: rows(rows), cols(cols), data((size_t)(rows + 1) * (cols + 1), Group::identity())
+	{
+	}
+
+	/**
+	 * @brief Constructor from a row-major array
+	 * @param values rows * cols values, values[r * cols + c] for 0-indexed (r, c)
+	 *
+	 * Pushes every node to its parent along the columns, then along the
+	 * rows, as in the one-dimensional linear build. Time complexity: O(rows * cols)
+	 */
+	FenwickTree2D(const T* values, int rows, int cols)
+		: FenwickTree2D(rows, cols)
+	{
+		for (int r = 1; r <= rows; ++r)
+			for (int c = 1; c <= cols; ++c)
+				at(r, c) = values[(size_t)(r - 1) * cols + (c - 1)];
+		for (int r = 1; r <= rows; ++r)
+			for (int c = 1; c <= cols; ++c) {
+				int parent = c + (c & -c);
+				if (parent <= cols)
+					at(r, parent) = Group::combine(at(r, parent), at(r, c));
+			}
+		for (int r = 1; r <= rows; ++r) {
+			int parent = r + (r & -r);
+			if (parent <= rows)
+				for (int c = 1; c <= cols; ++c)
+					at(parent, c) = Group::combine(at(parent, c), at(r, c));
+		}
+	}
+
+	/**
+	 * @brief Adds delta to cell (row, col), 1-indexed
+	 *
+	 * Time complexity: O(log rows * log cols)
+	 */
+	void update(int row, int col, const T& delta) {
+		for (int r = row; r <= rows; r += r & -r)
+			for (int c = col; c <= cols; c += c & -c)
+				at(r, c) = Group::combine(at(r, c), delta);
+	}
+
+	/**
+	 * @brief Calculates the sum of the rectangle [1, row] x [1, col]
+	 *
+	 * Time complexity: O(log rows * log cols)
+	 */
+	T querySum(int row, int col) const {
+		T result = Group::identity();
+		for (int r = row; r > 0; r -= r & -r)
+			for (int c = col; c > 0; c -= c & -c)
+				result = Group::combine(result, at(r, c));
+		return result;
+	}
+
+	/**
+	 * @brief Calculates the sum of the rectangle [top, bottom] x [left, right] (1-indexed, inclusive)
+	 *
+	 * Inclusion-exclusion over four prefix rectangles.
+	 */
+	T queryRectangle(int top, int left, int bottom, int right) const {
+		T inside = Group::combine(querySum(bottom, right), querySum(top - 1, left - 1));
+		T outside = Group::combine(querySum(top - 1, right), querySum(bottom, left - 1));
+		return Group::combine(inside, Group::inverse(outside));
+	}
+
+	/**
+	 * @brief Returns the number of rows
+	 */
+	int rowCount() const {
+		return rows;
+	}
+
+	/**
+	 * @brief Returns the number of columns
+	 */
+	int columnCount() const {
+		return cols;
+	}
+
+private:
+	T& at(int r, int c) {
+		return data[(size_t)r * (cols + 1) + c];
+	}
+
+	const T& at(int r, int c) const {
+		return data[(size_t)r * (cols + 1) + c];
+	}
+
+	int rows;             ///< Number of rows
+	int cols;             ///< Number of columns
+	std::vector<T> data;  ///< Row-major nodes, row 0 and column 0 unused
+};
@@ -0,0 +1,268 @@
+/**
+ * @file kruskal.h
+ * @brief Minimum spanning forest by Kruskal's algorithm on DisjointSet
+ *
+ * Computes a minimum spanning forest of a weighted edge list. Sorting the
+ * edges usually dominates Kruskal's algorithm, so the edges are LSD radix
+ * sorted on their weight bits instead of compared, and the optional
+ * Filter-Kruskal mode avoids sorting most of the heavy edges at all.
+ *
+ * Features:
+ * - Radix sort on an order-preserving key for unsigned, signed and
+ *   floating-point weights; byte passes that would not move anything are skipped
+ * - Early exit once V-1 edges are accepted (the graph is connected)
+ * - Filter-Kruskal (Osipov, Sanders, Singler): partition the edges around a
+ *   pivot weight, solve the light half, then drop heavy edges whose
+ *   endpoints are already connected before recursing on them
+ * - Time spent filtering, sorting and uniting is reported per run
+ *
+ * Time complexity: O(k m + m α(n)) for k radix passes (k <= sizeof(Weight))
+ */
+
+// filepath: e:\Playground\kruskal.h
+#pragma once
+#include "disjointSet.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Undirected weighted edge
+ */
+template<typename Weight>
+struct WeightedEdge {
+	uint32_t u;     ///< First endpoint
+	uint32_t v;     ///< Second endpoint
+	Weight weight;  ///< Edge weight
+};
+
+/**
+ * @brief Seconds spent in each stage of a Kruskal run
+ */
+struct KruskalTimings {
+	double filter = 0;  ///< Partitioning and dropping already-connected edges
+	double sort = 0;    ///< Radix sorting
+	double unite = 0;   ///< Union-find over the sorted edges
+};
+
+/**
+ * @brief Result of a Kruskal run
+ */
+template<typename Weight>
+struct SpanningForest {
+	std::vector<WeightedEdge<Weight>> edges;  ///< Accepted edges, by ascending weight
+	double totalWeight = 0;                   ///< Sum of the accepted weights
+	uint32_t components = 0;                  ///< Trees in the forest (1 if the graph is connected)
+	KruskalTimings timings;                   ///< Stage breakdown
+};
+
+/**
+ * @brief Order-preserving unsigned radix keys for the supported weight types
+ *
+ * Signed integers get their sign bit flipped; IEEE floats additionally
+ * have all bits flipped when negative, so comparing keys as unsigned
+ * integers orders them like the original values.
+ */
+inline uint32_t RadixKey(uint32_t w) { return w; }
+inline uint64_t RadixKey(uint64_t w) { return w; }
+inline uint32_t RadixKey(int32_t w) { return (uint32_t)w ^ 0x80000000u; }
+inline uint64_t RadixKey(int64_t w) { return (uint64_t)w ^ 0x8000000000000000ull; }
+
+inline uint32_t RadixKey(float w) {
+	uint32_t bits;
+	memcpy(&bits, &w, sizeof(bits));
+	return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+inline uint64_t RadixKey(double w) {
+	uint64_t bits;
+	memcpy(&bits, &w, sizeof(bits));
+	return (bits & 0x8000000000000000ull) ? ~bits : bits | 0x8000000000000000ull;
+}
+
+/**
+ * @class Kruskal
+ * @brief Runs the radix-sorted and Filter-Kruskal variants
+ */
+class Kruskal {
+public:
+	static const size_t SmallSort = 64;          ///< Below this many edges std::sort beats radix passes
+	static const size_t FilterBaseCase = 1 << 14; ///< Filter-Kruskal sorts directly below this many edges
+
+	/**
+	 * @brief Computes a minimum spanning forest
+	 * @param vertices Number of vertices; endpoints must be < vertices
+	 * @param edges Edge list, consumed (sorted and partitioned in place)
+	 * @param filter Use Filter-Kruskal instead of sorting every edge
+	 * @return Accepted edges, total weight, component count and timings
+	 */
+	template<typename Weight>
+	static SpanningForest<Weight> Run(uint32_t vertices, std::vector<WeightedEdge<Weight>> edges, bool filter = false) {
+		SpanningForest<Weight> forest;
+		if (vertices > 0)
+			forest.edges.reserve(std::min<size_t>(edges.size(), vertices - 1));
+		DisjointSet<> sets(vertices);
+		std::vector<WeightedEdge<Weight>> scratch;
+
+		if (filter) {
+			std::mt19937 random(5);
+			FilterKruskal(edges.data(), edges.size(), sets, scratch, random, forest);
+		}
+		else {
+			Sort(edges.data(), edges.size(), scratch, forest.timings);
+			Unite(edges.data(), edges.size(), sets, forest);
+		}
+		forest.components = sets.componentCount();
+		return forest;
+	}
+
+	/**
+	 * @brief Sorts edges by ascending weight with an LSD radix sort
+	 * @param edges Edges to sort in place
+	 * @param count Number of edges
+	 * @param scratch Buffer reused between calls, grown to count
+	 *
+	 * One pass computes the histograms of every key byte; each byte then
+	 * costs one scatter pass, except bytes on which all keys agree.
+	 */
+	template<typename Weight>
+	static void RadixSort(WeightedEdge<Weight>* edges, size_t count, std::vector<WeightedEdge<Weight>>& scratch) {
+		typedef decltype(RadixKey(Weight())) Key;
+		const int digits = sizeof(Key);
+		if (count < SmallSort) {
+			std::sort(edges, edges + count, [](const WeightedEdge<Weight>& a, const WeightedEdge<Weight>& b) {
+				return RadixKey(a.weight) < RadixKey(b.weight);
+			});
+			return;
+		}
+		if (scratch.size() < count)
+			scratch.resize(count);
+
+		std::vector<size_t> histogram(digits * 256, 0);
+		for (size_t k = 0; k < count; ++k) {
+			Key key = RadixKey(edges[k].weight);
+			for (int d = 0; d < digits; ++d)
+				histogram[d * 256 + ((key >> (8 * d)) & 0xff)] += 1;
+		}
+
+		WeightedEdge<Weight>* from = edges;
+		WeightedEdge<Weight>* to = scratch.data();
+		for (int d = 0; d < digits; ++d) {
+			size_t* counts = &histogram[d * 256];
+			Key first = (RadixKey(from[0].weight) >> (8 * d)) & 0xff;
+			if (counts[first] == count)
+				continue;
+			size_t offset = 0;
+			for (int b = 0; b < 256; ++b) {
+				size_t n = counts[b];
+				counts[b] = offset;
+				offset += n;
+			}
+			for (size_t k = 0; k < count; ++k)
+				to[counts[(RadixKey(from[k].weight) >> (8 * d)) & 0xff]++] = from[k];
+			std::swap(from, to);
+		}
+		if (from != edges)
+			memcpy(edges, from, count * sizeof(WeightedEdge<Weight>));
+	}
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	static double Seconds(Clock::time_point start) {
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Weight>
+	static void Sort(WeightedEdge<Weight>* edges, size_t count, std::vector<WeightedEdge<Weight>>& scratch,
+		KruskalTimings& timings) {
+		Clock::time_point start = Clock::now();
+		RadixSort(edges, count, scratch);
+		timings.sort += Seconds(start);
+	}
+
+	/**
+	 * @brief Feeds sorted edges through the union-find, stopping at V-1 accepted edges
+	 */
+	template<typename Weight>
+	static void Unite(const WeightedEdge<Weight>* edges, size_t count, DisjointSet<>& sets, SpanningForest<Weight>& forest) {
+		Clock::time_point start = Clock::now();
+		for (size_t k = 0; k < count && sets.componentCount() > 1; ++k) {
+			if (k + DisjointSet<>::PrefetchDistance < count) {
+				sets.prefetch(edges[k + DisjointSet<>::PrefetchDistance].u);
+				sets.prefetch(edges[k + DisjointSet<>::PrefetchDistance].v);
+			}
+			if (sets.unionElements(edges[k].u, edges[k].v)) {
+				forest.edges.push_back(edges[k]);
+				forest.totalWeight += (double)edges[k].weight;
+			}
+		}
+		forest.timings.unite += Seconds(start);
+	}
+
+	/**
+	 * @brief Removes edges whose endpoints are already connected
+	 * @return Number of edges kept, compacted to the front
+	 */
+	template<typename Weight>
+	static size_t Filter(WeightedEdge<Weight>* edges, size_t count, DisjointSet<>& sets) {
+		size_t kept = 0;
+		for (size_t k = 0; k < count; ++k) {
+			if (k + DisjointSet<>::PrefetchDistance < count) {
+				sets.prefetch(edges[k + DisjointSet<>::PrefetchDistance].u);
+				sets.prefetch(edges[k + DisjointSet<>::PrefetchDistance].v);
+			}
+			if (!sets.sameSet(edges[k].u, edges[k].v))
+				edges[kept++] = edges[k];
+		}
+		return kept;
+	}
+
+	/**
+	 * @brief Filter-Kruskal recursion over edges[0, count)
+	 *
+	 * Splits the edges three ways around a random pivot weight. The light
+	 * part is solved first; the equal part needs no sorting; the heavy part
+	 * is filtered against the forest built so far and only its survivors
+	 * are recursed on. Everything stops once the graph is connected.
+	 */
+	template<typename Weight>
+	static void FilterKruskal(WeightedEdge<Weight>* edges, size_t count, DisjointSet<>& sets,
+		std::vector<WeightedEdge<Weight>>& scratch, std::mt19937& random, SpanningForest<Weight>& forest) {
+		if (count == 0 || sets.componentCount() == 1)
+			return;
+		if (count <= FilterBaseCase) {
+			Sort(edges, count, scratch, forest.timings);
+			Unite(edges, count, sets, forest);
+			return;
+		}
+
+		Clock::time_point start = Clock::now();
+		auto pivot = RadixKey(edges[random() % count].weight);
+		WeightedEdge<Weight>* light = std::partition(edges, edges + count,
+			[pivot](const WeightedEdge<Weight>& e) { return RadixKey(e.weight) < pivot; });
+		WeightedEdge<Weight>* heavy = std::partition(light, edges + count,
+			[pivot](const WeightedEdge<Weight>& e) { return RadixKey(e.weight) == pivot; });
+		forest.timings.filter += Seconds(start);
+
+		FilterKruskal(edges, light - edges, sets, scratch, random, forest);
+		if (sets.componentCount() == 1)
+			return;
+
+		start = Clock::now();
+		size_t equal = Filter(light, heavy - light, sets);
+		forest.timings.filter += Seconds(start);
+		Unite(light, equal, sets, forest);
+		if (sets.componentCount() == 1)
+			return;
+
+		start = Clock::now();
+		size_t remaining = Filter(heavy, edges + count - heavy, sets);
+		forest.timings.filter += Seconds(start);
+		FilterKruskal(heavy, remaining, sets, scratch, random, forest);
+	}
+};
@@ -0,0 +1,88 @@
+// Benchmark for the Kruskal engine: computes the minimum spanning forest of
+// a random graph with a std::sort baseline, the radix-sorted Kruskal and
+// Filter-Kruskal, checks that all three agree on the total weight and
+// prints the filter/sort/union breakdown of each run.
+//
+// Build: g++ -O2 -std=c++17 -pthread kruskalBenchmark.cpp -o kruskalBenchmark
+// Usage: ./kruskalBenchmark [vertices] [edgesPerVertex]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include "kruskal.h"
+
+typedef WeightedEdge<uint32_t> Edge32;
+
+/**
+ * Random multigraph with a Hamiltonian path so it is connected
+ */
+std::vector<Edge32> randomGraph(uint32_t n, uint64_t m) {
+	std::mt19937 random(3);
+	std::vector<Edge32> edges;
+	edges.reserve(m + n);
+	for (uint32_t i = 1; i < n; ++i)
+		edges.push_back(Edge32{ i - 1, i, (uint32_t)random() });
+	for (uint64_t k = 0; k < m; ++k)
+		edges.push_back(Edge32{ (uint32_t)(random() % n), (uint32_t)(random() % n), (uint32_t)random() });
+	return edges;
+}
+
+/**
+ * Classic Kruskal: comparison sort, then union every edge
+ */
+SpanningForest<uint32_t> baseline(uint32_t n, std::vector<Edge32> edges) {
+	SpanningForest<uint32_t> forest;
+	auto start = std::chrono::steady_clock::now();
+	std::sort(edges.begin(), edges.end(), [](const Edge32& a, const Edge32& b) { return a.weight < b.weight; });
+	auto sorted = std::chrono::steady_clock::now();
+	DisjointSet<> sets(n);
+	for (const Edge32& e : edges) {
+		if (sets.unionElements(e.u, e.v)) {
+			forest.edges.push_back(e);
+			forest.totalWeight += e.weight;
+		}
+	}
+	forest.timings.sort = std::chrono::duration<double>(sorted - start).count();
+	forest.timings.unite = std::chrono::duration<double>(std::chrono::steady_clock::now() - sorted).count();
+	forest.components = sets.componentCount();
+	return forest;
+}
+
+void report(const char* name, const SpanningForest<uint32_t>& forest, double total, double expected) {
+	std::cout << std::setw(16) << name
+		<< std::setw(10) << forest.timings.filter
+		<< std::setw(10) << forest.timings.sort
+		<< std::setw(10) << forest.timings.unite
+		<< std::setw(10) << total
+		<< std::setw(10) << forest.edges.size()
+		<< (forest.totalWeight != expected ? "   mismatch!" : "") << "\n";
+}
+
+int main(int argc, char** argv) {
+	uint32_t n = argc > 1 ? (uint32_t)atol(argv[1]) : 1000000;
+	uint64_t perVertex = argc > 2 ? (uint64_t)atol(argv[2]) : 8;
+	std::vector<Edge32> edges = randomGraph(n, n * perVertex);
+	std::cout << "Kruskal, " << n << " vertices, " << edges.size() << " edges (seconds)\n";
+	std::cout << std::setw(16) << "variant" << std::setw(10) << "filter" << std::setw(10) << "sort"
+		<< std::setw(10) << "union" << std::setw(10) << "total" << std::setw(10) << "accepted" << "\n";
+	std::cout << std::fixed << std::setprecision(3);
+
+	auto start = std::chrono::steady_clock::now();
+	SpanningForest<uint32_t> reference = baseline(n, edges);
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	report("std::sort", reference, elapsed.count(), reference.totalWeight);
+
+	start = std::chrono::steady_clock::now();
+	SpanningForest<uint32_t> radix = Kruskal::Run(n, edges);
+	elapsed = std::chrono::steady_clock::now() - start;
+	report("radix", radix, elapsed.count(), reference.totalWeight);
+
+	start = std::chrono::steady_clock::now();
+	SpanningForest<uint32_t> filtered = Kruskal::Run(n, edges, true);
+	elapsed = std::chrono::steady_clock::now() - start;
+	report("filter-kruskal", filtered, elapsed.count(), reference.totalWeight);
+}
@@ -0,0 +1,104 @@
+// Throughput benchmark: LockFreeStack against a mutex-protected Stack.
+// Every thread runs a 50/50 mix of pushes and pops on one shared stack.
+//
+// Build: g++ -O2 -std=c++17 -pthread lockFreeStackBenchmark.cpp -o lockFreeStackBenchmark
+// Usage: ./lockFreeStackBenchmark [opsPerThread] [maxThreads]
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <stdlib.h>
+#include "LockFreeStack.h"
+#include "Stack.h"
+
+/**
+ * Stack guarded by a single mutex, the baseline for the comparison
+ */
+class MutexStack {
+public:
+	void Push(int data) {
+		std::lock_guard<std::mutex> lock(mutex);
+		stack.Push(data);
+	}
+
+	bool TryPop(int& data) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stack.IsEmpty())
+			return false;
+		data = stack.Top();
+		stack.Pop();
+		return true;
+	}
+
+private:
+	std::mutex mutex;
+	Stack stack;
+};
+
+/**
+ * Runs the push/pop mix on the given stack
+ * @return Operations per second over all threads
+ */
+template<typename SharedStack>
+double run(SharedStack& stack, int threads, long long opsPerThread) {
+	std::vector<std::thread> workers;
+	std::atomic<long long> balance(0);
+
+	for (int i = 0; i < 1024; ++i)
+		stack.Push(i);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&stack, &balance, opsPerThread, t] {
+			uint32_t state = 2463534242u + t;
+			long long pushed = 0, popped = 0;
+			int value;
+			for (long long i = 0; i < opsPerThread; ++i) {
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				if (state & 1) {
+					stack.Push((int)i);
+					++pushed;
+				}
+				else if (stack.TryPop(value)) {
+					++popped;
+				}
+			}
+			balance += pushed - popped;
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	long long remaining = 0;
+	int value;
+	while (stack.TryPop(value))
+		++remaining;
+	if (remaining != balance + 1024)
+		std::cout << "element count mismatch!\n";
+	return threads * opsPerThread / elapsed.count();
+}
+
+int main(int argc, char** argv) {
+	long long opsPerThread = argc > 1 ? atoll(argv[1]) : 2000000LL;
+	int maxThreads = argc > 2 ? atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+	std::cout << "Stack push/pop mix, " << opsPerThread << " ops per thread, "
+		<< std::thread::hardware_concurrency() << " hardware threads\n";
+	std::cout << "  threads | lock-free (M ops/s) | mutex (M ops/s)\n";
+	std::cout << std::fixed << std::setprecision(1);
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		LockFreeStack lockFree;
+		MutexStack locked;
+		double a = run(lockFree, threads, opsPerThread);
+		double b = run(locked, threads, opsPerThread);
+		std::cout << "  " << std::setw(7) << threads << " | " << std::setw(19) << a / 1e6
+			<< " | " << std::setw(15) << b / 1e6 << "\n";
+	}
+}
@@ -0,0 +1,89 @@
+// Contention benchmark for MpmcQueue: P producers and P consumers for
+// P = 1, 2, 4, ... up to the requested thread count, with single-element
+// and batched transfers.
+//
+// Build: g++ -O2 -std=c++17 -pthread mpmcQueueBenchmark.cpp -o mpmcQueueBenchmark
+// Usage: ./mpmcQueueBenchmark [items] [maxThreadsPerSide] [batch]
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <stdlib.h>
+#include "MpmcQueue.h"
+
+/**
+ * Runs producers and consumers over one queue
+ * @param batch 1 for Push/Pop, otherwise the PushN/PopN batch size
+ * @return Items per second
+ */
+double run(long long items, int threads, int batch) {
+	MpmcQueue queue(1 << 14);
+	std::atomic<long long> checksum(0);
+	std::vector<std::thread> workers;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < threads; ++t) {
+		long long begin = items * t / threads;
+		long long end = items * (t + 1) / threads;
+
+		workers.emplace_back([&queue, begin, end, batch] {
+			if (batch == 1) {
+				for (long long i = begin; i < end; ++i)
+					queue.Push((int)i);
+				return;
+			}
+			std::vector<int> in(batch);
+			for (long long i = begin; i < end; i += batch) {
+				int n = (int)std::min<long long>(batch, end - i);
+				for (int k = 0; k < n; ++k)
+					in[k] = (int)(i + k);
+				queue.PushN(in.data(), n);
+			}
+		});
+
+		workers.emplace_back([&queue, &checksum, begin, end, batch] {
+			long long sum = 0;
+			long long remaining = end - begin;
+			if (batch == 1) {
+				for (; remaining > 0; --remaining)
+					sum += queue.Pop();
+			}
+			else {
+				std::vector<int> out(batch);
+				while (remaining > 0) {
+					int n = queue.PopN(out.data(), (int)std::min<long long>(batch, remaining));
+					for (int k = 0; k < n; ++k)
+						sum += out[k];
+					remaining -= n;
+				}
+			}
+			checksum += sum;
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (checksum != items * (items - 1) / 2)
+		std::cout << "checksum mismatch!\n";
+	return items / elapsed.count();
+}
+
+int main(int argc, char** argv) {
+	long long items = argc > 1 ? atoll(argv[1]) : 20000000LL;
+	int maxThreads = argc > 2 ? atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency() / 2);
+	int batch = argc > 3 ? atoi(argv[3]) : 32;
+
+	std::cout << "MpmcQueue, " << items << " items, " << std::thread::hardware_concurrency()
+		<< " hardware threads\n";
+	std::cout << "  producers+consumers | single (M items/s) | batch " << batch << " (M items/s)\n";
+	std::cout << std::fixed << std::setprecision(1);
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		std::cout << "  " << std::setw(9) << threads << " + " << std::setw(7) << std::left << threads
+			<< std::right << " | " << std::setw(18) << run(items, threads, 1) / 1e6
+			<< " | " << std::setw(18) << run(items, threads, batch) / 1e6 << "\n";
+	}
+}
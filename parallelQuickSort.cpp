@@ -0,0 +1,98 @@
+// Example: the quick_sort_req recursion from sortingAlgorithms.h run in
+// parallel on TaskScheduler. Each partition spawns its larger half and
+// recurses into the smaller half itself; below a cutoff the sequential
+// quick_sort_req takes over so tasks stay coarse enough to pay off.
+//
+// Build: g++ -O2 -std=c++17 -pthread parallelQuickSort.cpp -o parallelQuickSort
+// Usage: ./parallelQuickSort [size] [threads]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <stdlib.h>
+#include "sortingAlgorithms.h"
+#include "TaskScheduler.h"
+
+const int SequentialCutoff = 1 << 14;  // Subarrays smaller than this are sorted in place
+
+/**
+ * Parallel version of quick_sort_req
+ * @param scheduler Pool the halves are spawned on
+ * @param arr Array to sort
+ * @param start Starting index
+ * @param end Ending index
+ */
+void parallel_quick_sort_req(TaskScheduler& scheduler, int* arr, int start, int end) {
+	if (end - start < SequentialCutoff) {
+		quick_sort_req(arr, start, end);
+		return;
+	}
+	int pi = partition(arr, start, end);
+	int smallStart = start, smallEnd = pi - 1;
+	int largeStart = pi + 1, largeEnd = end;
+	if (pi - start > end - pi) {
+		std::swap(smallStart, largeStart);
+		std::swap(smallEnd, largeEnd);
+	}
+	TaskGroup group(scheduler);
+	group.Spawn([&scheduler, arr, largeStart, largeEnd] {
+		parallel_quick_sort_req(scheduler, arr, largeStart, largeEnd);
+	});
+	parallel_quick_sort_req(scheduler, arr, smallStart, smallEnd);
+	group.Sync();
+}
+
+/**
+ * Sorts the whole array on the scheduler
+ */
+void parallel_quick_sort(TaskScheduler& scheduler, int* arr, int size) {
+	parallel_quick_sort_req(scheduler, arr, 0, size - 1);
+}
+
+/**
+ * Times one sort of a copy of the input
+ * @return Seconds taken
+ */
+template<typename Sort>
+double time_sort(const std::vector<int>& input, Sort sort) {
+	std::vector<int> data(input);
+	auto start = std::chrono::steady_clock::now();
+	sort(data.data(), (int)data.size());
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	if (!is_sorted(data.data(), (int)data.size()))
+		std::cout << "not sorted!\n";
+	return elapsed.count();
+}
+
+int main(int argc, char** argv) {
+	int size = argc > 1 ? atoi(argv[1]) : 20000000;
+	int threads = argc > 2 ? atoi(argv[2]) : 0;
+
+	std::vector<int> input(size);
+	std::mt19937 random(42);
+	for (int& x : input)
+		x = (int)random();
+
+	TaskScheduler scheduler(threads);
+	std::cout << "quick sort of " << size << " ints, " << scheduler.ThreadCount() << " workers\n";
+	std::cout << std::fixed << std::setprecision(3);
+
+	double sequential = time_sort(input, quick_sort);
+	double parallel = time_sort(input, [&scheduler](int* arr, int n) {
+		parallel_quick_sort(scheduler, arr, n);
+	});
+	std::cout << "  sequential: " << sequential << " s\n";
+	std::cout << "  parallel:   " << parallel << " s (" << sequential / parallel << "x)\n";
+
+	// Few distinct keys: equal elements must still split evenly
+	for (int& x : input)
+		x = (int)(random() % 100);
+	sequential = time_sort(input, quick_sort);
+	parallel = time_sort(input, [&scheduler](int* arr, int n) {
+		parallel_quick_sort(scheduler, arr, n);
+	});
+	std::cout << "  duplicates, sequential: " << sequential << " s\n";
+	std::cout << "  duplicates, parallel:   " << parallel << " s (" << sequential / parallel << "x)\n";
+}
@@ -0,0 +1,114 @@
+/**
+ * @file rangeFenwickTree.h
+ * @brief Fenwick Tree with range updates and range queries
+ *
+ * Supports adding a value to every element of a range and summing any
+ * range, both in O(log n), e.g. for time-bucketed metrics where an event
+ * contributes to a whole span of buckets.
+ *
+ * Uses two FenwickTrees over the difference array d (a[i] = d[1] + ... + d[i]):
+ * B1 stores d[i] and B2 stores d[i] * (i - 1), so that
+ * prefixSum(i) = B1.querySum(i) * i - B2.querySum(i).
+ *
+ * Time complexity: O(log n) for updates and queries, O(n) to build
+ * Space complexity: O(n)
+ */
+
+// filepath: e:\Playground\rangeFenwickTree.h
+#pragma once
+#include "fenwickTree.h"
+#include <vector>
+#include <stddef.h>
+
+/**
+ * @class RangeFenwickTree
+ * @brief Range-add, range-sum Fenwick Tree over 1-indexed elements
+ * @tparam T Arithmetic value type; must support multiplication by an index
+ */
+template<typename T = long long>
+class RangeFenwickTree {
+public:
+	/**
+	 * @brief Constructor for n zero elements
+	 */
+	explicit RangeFenwickTree(size_t n)
+		: linear(n), offset(n)
+	{
+	}
+
+	/**
+	 * @brief Constructor from initial values
+	 * @param values Pointer to n values (0-indexed)
+	 * @param n Number of values
+	 *
+	 * Builds both trees from the difference array in O(n).
+	 */
+	RangeFenwickTree(const T* values, size_t n)
+		: linear(Differences(values, n, false)), offset(Differences(values, n, true))
+	{
+	}
+
+	RangeFenwickTree(const std::vector<T>& values)
+		: RangeFenwickTree(values.data(), values.size())
+	{
+	}
+
+	/**
+	 * @brief Adds delta to every element in [left, right] (1-indexed, inclusive)
+	 *
+	 * Time complexity: O(log n)
+	 */
+	void rangeAdd(int left, int right, const T& delta) {
+		linear.update(left, delta);
+		linear.update(right + 1, -delta);
+		offset.update(left, delta * (T)(left - 1));
+		offset.update(right + 1, -delta * (T)right);
+	}
+
+	/**
+	 * @brief Adds delta to a single element (1-indexed)
+	 */
+	void update(int index, const T& delta) {
+		rangeAdd(index, index, delta);
+	}
+
+	/**
+	 * @brief Calculates the sum of elements 1..index
+	 *
+	 * Time complexity: O(log n)
+	 */
+	T querySum(int index) const {
+		return linear.querySum(index) * (T)index - offset.querySum(index);
+	}
+
+	/**
+	 * @brief Calculates the sum of elements in [left, right] (1-indexed, inclusive)
+	 */
+	T queryRange(int left, int right) const {
+		return querySum(right) - querySum(left - 1);
+	}
+
+	/**
+	 * @brief Returns the number of elements
+	 */
+	int size() const {
+		return linear.size();
+	}
+
+private:
+	/**
+	 * @brief Difference array d[i] = a[i] - a[i-1], optionally scaled by (i - 1)
+	 */
+	static std::vector<T> Differences(const T* values, size_t n, bool scaled) {
+		std::vector<T> d(n);
+		for (size_t i = 0; i < n; ++i) {
+			d[i] = i ? values[i] - values[i - 1] : values[0];
+			if (scaled)
+				d[i] = d[i] * (T)i;
+		}
+		return d;
+	}
+
+	FenwickTree<T> linear;  ///< B1: difference array
+	FenwickTree<T> offset;  ///< B2: difference array times (i - 1)
+};
@@ -0,0 +1,144 @@
+/**
+ * @file rollbackDisjointSet.h
+ * @brief Union-Find whose unions can be undone
+ *
+ * A DisjointSet variant for algorithms that explore and backtrack, such as
+ * offline dynamic connectivity: every union is recorded in an undo log and
+ * the structure can be rolled back to any earlier snapshot.
+ *
+ * Features:
+ * - Union by rank, no path compression, so each union changes O(1) entries
+ * - Undo log of parent and rank changes
+ * - snapshot()/rollback(snapshot) in O(number of undone unions)
+ * - Component count maintained through unions and rollbacks
+ *
+ * Time complexity: O(log n) for find and union, O(1) per undone union
+ */
+
+// filepath: e:\Playground\rollbackDisjointSet.h
+#pragma once
+#include <vector>
+#include <utility>
+#include <stddef.h>
+#include <assert.h>
+
+/**
+ * @class RollbackDisjointSet
+ * @brief Union-Find with an undo log
+ *
+ * Path compression would make a single find rewrite many parents and
+ * defeat cheap rollback, so it is left out; union by rank alone keeps
+ * every tree at most log2(n) deep.
+ */
+class RollbackDisjointSet {
+public:
+	/**
+	 * @brief Constructor for n elements
+	 * @param n Number of elements; they are identified by 0..n-1
+	 */
+	explicit RollbackDisjointSet(int n)
+		: parent(n), rank(n, 0), components(n)
+	{
+		for (int i = 0; i < n; ++i)
+			parent[i] = i;
+	}
+
+	/**
+	 * @brief Finds the root of the set containing element i
+	 *
+	 * Does not modify the structure. Time complexity: O(log n)
+	 */
+	int find(int i) const {
+		while (parent[i] != i)
+			i = parent[i];
+		return i;
+	}
+
+	/**
+	 * @brief Unites the sets containing elements a and b
+	 * @return true if the sets were different and have been merged
+	 *
+	 * Links the root of lower rank under the other and logs the change.
+	 * Unions that merge nothing are not logged.
+	 */
+	bool unionElements(int a, int b) {
+		a = find(a);
+		b = find(b);
+		if (a == b)
+			return false;
+		if (rank[a] > rank[b])
+			std::swap(a, b);
+		bool rankIncreased = rank[a] == rank[b];
+		parent[a] = b;
+		if (rankIncreased)
+			rank[b] += 1;
+		components -= 1;
+		history.push_back(Change{a, rankIncreased});
+		return true;
+	}
+
+	/**
+	 * @brief Checks if two elements belong to the same set
+	 */
+	bool sameSet(int a, int b) const {
+		return find(a) == find(b);
+	}
+
+	/**
+	 * @brief Returns a token for the current state
+	 *
+	 * Snapshots are positions in the undo log; they stay valid as long as
+	 * no rollback goes past them.
+	 */
+	size_t snapshot() const {
+		return history.size();
+	}
+
+	/**
+	 * @brief Undoes every union made since the snapshot was taken
+	 * @param snapshot Value returned by snapshot()
+	 *
+	 * Time complexity: O(number of undone unions)
+	 */
+	void rollback(size_t snapshot) {
+		if (snapshot > history.size())
+			assert(false);
+		while (history.size() > snapshot) {
+			Change change = history.back();
+			history.pop_back();
+			int root = parent[change.child];
+			parent[change.child] = change.child;
+			if (change.rankIncreased)
+				rank[root] -= 1;
+			components += 1;
+		}
+	}
+
+	/**
+	 * @brief Returns the current number of disjoint sets
+	 */
+	int componentCount() const {
+		return components;
+	}
+
+	/**
+	 * @brief Returns the number of elements
+	 */
+	int elementCount() const {
+		return (int)parent.size();
+	}
+
+private:
+	/**
+	 * @brief One logged union: child was a root and got linked under another root
+	 */
+	struct Change {
+		int child;           ///< Root that was linked
+		bool rankIncreased;  ///< The new parent's rank was incremented
+	};
+
+	std::vector<int> parent;      ///< Parent of each element
+	std::vector<int> rank;        ///< Upper bound on tree height, valid for roots
+	std::vector<Change> history;  ///< Undo log, most recent union last
+	int components;               ///< Number of disjoint sets
+};
@@ -274,7 +274,9 @@ void binary_insertion_sort(int* arr, int size){
 /**
  * Partition function for quicksort
  * Rearranges array so elements smaller than pivot are on left,
- * larger elements are on right
+ * larger elements are on right; elements equal to the pivot stop both
+ * scans and are swapped, so they end up split between the two sides
+ * and duplicate-heavy input still partitions evenly
  * @param arr Array to partition
  * @param start Starting index
  * @param end Ending index
@@ -283,54 +285,49 @@ void binary_insertion_sort(int* arr, int size){
 int partition(int* arr, int start, int end) {
 	int pivot = start + (end - start) / 2; // Middle item
 	swap(arr[pivot], arr[end]); // Moving the pivot to the end
+	pivot = arr[end];
 	int left = start;
 	int right = end - 1;
-	pivot = end;
-
-	while (left < right) {
-		left = -1;
-		right = -1;
-		// get the smallest and largest
-		for (int i = start; i < end; ++i) {
-			if (arr[i] > arr[pivot])
-			{
-				left = i;
-				break;
-			}
-		}
 
-		for (int i = end - 1; i >= start; --i) {
-			if (arr[i] < arr[pivot])
-			{
-				right = i;
-				break;
-			}
-		}
+	for (;;) {
+		// Everything before left is <= pivot and everything after right is >= pivot.
+		// The pivot at arr[end] stops the left scan.
+		while (arr[left] < pivot)
+			++left;
+		while (right > left && arr[right] > pivot)
+			--right;
 
-		if (left > right)
+		if (left >= right)
 			break;
 
-		if (left != -1 && right != -1)
-			swap(arr[left], arr[right]);
+		swap(arr[left], arr[right]);
+		++left;
+		--right;
 	}
-	if (left != -1 && arr[left] > arr[pivot])
-		swap(arr[pivot], arr[left]); // getting the smallest at the pivot instead of keeping it in the middle
+	swap(arr[end], arr[left]); // getting the pivot between the two halves (no-op if it is the largest)
 
 	return left; // the actual partition point.
 }
 
 /**
  * Recursive helper function for quicksort
+ * Recurses into the smaller side and loops on the larger one, so the
+ * stack depth stays O(log n) whatever the pivots turn out to be.
  * @param arr Array to sort
  * @param start Starting index
  * @param end Ending index
  */
 void quick_sort_req(int* arr, int start, int end) {
-	if (start >= end)
-		return;
-	int pi = partition(arr, start, end);
-	quick_sort_req(arr, start, pi);
-	quick_sort_req(arr, pi + 1, end);
+	while (start < end) {
+		int pi = partition(arr, start, end);
+		if (pi - start < end - pi) {
+			quick_sort_req(arr, start, pi - 1);
+			start = pi + 1;
+		} else {
+			quick_sort_req(arr, pi + 1, end);
+			end = pi - 1;
+		}
+	}
 }
 
 /**
@@ -0,0 +1,124 @@
+// Throughput benchmark for SpscQueue: one producer and one consumer thread,
+// pinned to two different cores when the machine has them.
+//
+// Build: g++ -O2 -std=c++17 -pthread spscQueueBenchmark.cpp -o spscQueueBenchmark
+// Usage: ./spscQueueBenchmark [items] [producerCore] [consumerCore]
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "SpscQueue.h"
+
+void pin_to_core(int core) {
+	if (core < 0 || core >= (int)std::thread::hardware_concurrency())
+		return;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/**
+ * Moves items through the queue one element at a time
+ * @return Items per second
+ */
+double run_single(long long items, int producerCore, int consumerCore) {
+	SpscQueue queue(1 << 16);
+	long long checksum = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	std::thread consumer([&] {
+		pin_to_core(consumerCore);
+		long long sum = 0;
+		int value;
+		for (long long i = 0; i < items; ++i) {
+			while (!queue.TryPop(value))
+				std::this_thread::yield();
+			sum += value;
+		}
+		checksum = sum;
+	});
+
+	pin_to_core(producerCore);
+	for (long long i = 0; i < items; ++i)
+		while (!queue.TryPush((int)i))
+			std::this_thread::yield();
+	consumer.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (checksum != items * (items - 1) / 2)
+		std::cout << "checksum mismatch!\n";
+	return items / elapsed.count();
+}
+
+/**
+ * Moves items through the queue with PushN/PopN batches
+ * @return Items per second
+ */
+double run_batched(long long items, int batch, int producerCore, int consumerCore) {
+	SpscQueue queue(1 << 16);
+	long long checksum = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	std::thread consumer([&] {
+		pin_to_core(consumerCore);
+		std::vector<int> out(batch);
+		long long sum = 0;
+		long long received = 0;
+		while (received < items) {
+			int n = queue.PopN(out.data(), batch);
+			if (n == 0) {
+				std::this_thread::yield();
+				continue;
+			}
+			for (int i = 0; i < n; ++i)
+				sum += out[i];
+			received += n;
+		}
+		checksum = sum;
+	});
+
+	pin_to_core(producerCore);
+	std::vector<int> in(batch);
+	long long sent = 0;
+	while (sent < items) {
+		int n = (int)std::min<long long>(batch, items - sent);
+		for (int i = 0; i < n; ++i)
+			in[i] = (int)(sent + i);
+		int offset = 0;
+		while (offset < n) {
+			int pushed = queue.PushN(in.data() + offset, n - offset);
+			if (pushed == 0)
+				std::this_thread::yield();
+			offset += pushed;
+		}
+		sent += n;
+	}
+	consumer.join();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (checksum != items * (items - 1) / 2)
+		std::cout << "checksum mismatch!\n";
+	return items / elapsed.count();
+}
+
+int main(int argc, char** argv) {
+	long long items = argc > 1 ? atoll(argv[1]) : 100000000LL;
+	int producerCore = argc > 2 ? atoi(argv[2]) : 0;
+	int consumerCore = argc > 3 ? atoi(argv[3]) : 1;
+
+	std::cout << "SpscQueue, " << items << " items, cores " << producerCore
+		<< " -> " << consumerCore << " (" << std::thread::hardware_concurrency()
+		<< " available)\n";
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "  single push/pop : " << run_single(items, producerCore, consumerCore) / 1e6 << " M items/s\n";
+	for (int batch : {16, 64, 256}) {
+		std::cout << "  batch " << std::setw(3) << batch << "       : "
+			<< run_batched(items, batch, producerCore, consumerCore) / 1e6 << " M items/s\n";
+	}
+}